@@ -43,6 +43,15 @@ ifeq (${ENABLE_PMF}, 1)
 BL31_SOURCES		+=	lib/pmf/pmf_main.c
 endif
 
+ifeq (${ENABLE_SMC_LATENCY_STAT},1)
+BL31_SOURCES		+=	bl31/smc_latency.c
+endif
+
+ifeq (${CRASH_DUMP},1)
+BL31_SOURCES		+=	bl31/crash_dump.c				\
+				bl31/aarch64/crash_dump.S
+endif
+
 ifeq (${EL3_EXCEPTION_HANDLING},1)
 BL31_SOURCES		+=	bl31/ehf.c
 endif
@@ -93,9 +102,11 @@ CRASH_REPORTING		:=	$(DEBUG)
 endif
 
 $(eval $(call assert_boolean,CRASH_REPORTING))
+$(eval $(call assert_boolean,CRASH_DUMP))
 $(eval $(call assert_boolean,EL3_EXCEPTION_HANDLING))
 $(eval $(call assert_boolean,SDEI_SUPPORT))
 
 $(eval $(call add_define,CRASH_REPORTING))
+$(eval $(call add_define,CRASH_DUMP))
 $(eval $(call add_define,EL3_EXCEPTION_HANDLING))
 $(eval $(call add_define,SDEI_SUPPORT))
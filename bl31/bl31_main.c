@@ -10,6 +10,7 @@
 #include <arch.h>
 #include <arch_helpers.h>
 #include <bl31/bl31.h>
+#include <bl31/crash_dump.h>
 #include <bl31/ehf.h>
 #include <common/bl_common.h>
 #include <common/debug.h>
@@ -97,6 +98,11 @@ void bl31_main(void)
 	NOTICE("BL31: %s\n", version_string);
 	NOTICE("BL31: %s\n", build_message);
 
+#if CRASH_DUMP
+	/* Report crash dumps left by a previous boot */
+	crash_dump_init();
+#endif
+
 	/* Perform platform setup in BL31 */
 	bl31_platform_setup();
 
@@ -0,0 +1,84 @@
+/*
+ * Copyright (c) 2019, ARM Limited and Contributors. All rights reserved.
+ *
+ * SPDX-License-Identifier: BSD-3-Clause
+ */
+
+#include <assert.h>
+#include <stdbool.h>
+#include <stddef.h>
+
+#include <arch_helpers.h>
+#include <bl31/crash_dump.h>
+#include <common/debug.h>
+#include <plat/common/platform.h>
+
+/*
+ * Per-CPU crash dump records, filled in by crash_dump_capture(). They are
+ * placed in a NOLOAD section outside .bss so that they are not zeroed when
+ * BL31 boots, which allows a record captured before a warm reset to be
+ * retrieved on the next boot.
+ */
+crash_dump_rec_t crash_dump_recs[PLATFORM_CORE_COUNT] __section("crash_dump");
+
+static bool crash_dump_is_valid(const crash_dump_rec_t *rec)
+{
+	const uint64_t *data = (const uint64_t *)((uintptr_t)rec +
+						  CRASH_DUMP_DATA_OFFSET);
+	uint64_t sum = 0ULL;
+	unsigned int i;
+
+	if (rec->magic != CRASH_DUMP_MAGIC)
+		return false;
+
+	for (i = 0U; i < ((CRASH_DUMP_DATA_END - CRASH_DUMP_DATA_OFFSET) >>
+			  DWORD_SHIFT); i++)
+		sum += data[i];
+
+	return sum == rec->checksum;
+}
+
+/*******************************************************************************
+ * Return the crash dump record of a CPU, or NULL if it doesn't hold a complete
+ * crash dump.
+ ******************************************************************************/
+const crash_dump_rec_t *crash_dump_get(unsigned int core_pos)
+{
+	const crash_dump_rec_t *rec;
+
+	assert(core_pos < PLATFORM_CORE_COUNT);
+
+	rec = &crash_dump_recs[core_pos];
+
+	return crash_dump_is_valid(rec) ? rec : NULL;
+}
+
+/*******************************************************************************
+ * Report the crash dumps left by a previous boot. Each dump is reported once,
+ * and is kept in memory until the same CPU crashes again so that it can still
+ * be retrieved with crash_dump_get().
+ ******************************************************************************/
+void crash_dump_init(void)
+{
+	crash_dump_rec_t *rec;
+	unsigned int i;
+
+	for (i = 0U; i < PLATFORM_CORE_COUNT; i++) {
+		rec = &crash_dump_recs[i];
+
+		if (!crash_dump_is_valid(rec) ||
+		    (rec->status != CRASH_DUMP_STATUS_NEW))
+			continue;
+
+		NOTICE("BL31: Crash dump found for CPU %u (MPIDR 0x%llx)\n",
+		       i, rec->mpidr);
+		NOTICE("BL31:   x30: 0x%llx, ELR_EL3: 0x%llx, ESR_EL3: 0x%llx\n",
+		       rec->gpregs._regs[CTX_GPREG_LR >> DWORD_SHIFT],
+		       rec->el3_regs[CRASH_DUMP_ELR_EL3 >> DWORD_SHIFT],
+		       rec->el3_regs[CRASH_DUMP_ESR_EL3 >> DWORD_SHIFT]);
+
+		rec->status = CRASH_DUMP_STATUS_REPORTED;
+		flush_dcache_range((uintptr_t)&rec->status,
+				   sizeof(rec->status));
+	}
+}
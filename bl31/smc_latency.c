@@ -0,0 +1,126 @@
+/*
+ * Copyright (c) 2019, ARM Limited and Contributors. All rights reserved.
+ *
+ * SPDX-License-Identifier: BSD-3-Clause
+ */
+
+#include <stdint.h>
+
+#include <platform_def.h>
+
+#include <arch_helpers.h>
+#include <bl31/smc_latency.h>
+#include <lib/pmf/pmf.h>
+#include <plat/common/platform.h>
+
+typedef struct smc_lat_slot {
+	uint32_t fid;
+	uint32_t buckets[SMC_LAT_BUCKETS];
+	uint64_t count;
+	uint64_t min;
+	uint64_t max;
+} smc_lat_slot_t;
+
+/*
+ * The statistics of a CPU are only ever written by that CPU, so no locking is
+ * needed. A reader on another CPU may see a partially updated slot.
+ */
+typedef struct smc_lat_stats {
+	unsigned int num_slots;
+	smc_lat_slot_t slots[SMC_LAT_MAX_FIDS];
+} __aligned(CACHE_WRITEBACK_GRANULE) smc_lat_stats_t;
+
+static smc_lat_stats_t smc_lat_stats[PLATFORM_CORE_COUNT];
+
+static unsigned long long smc_lat_get_stat(unsigned int tid,
+					   u_register_t mpidr,
+					   unsigned int flags);
+
+PMF_REGISTER_SERVICE_SMC_OWN(smc_lat_svc, PMF_ARM_TIF_IMPL_ID,
+	PMF_SMC_LAT_SVC_ID, SMC_LAT_TOTAL_IDS, NULL, smc_lat_get_stat)
+
+static smc_lat_slot_t *smc_lat_find_slot(smc_lat_stats_t *stats, uint32_t fid)
+{
+	smc_lat_slot_t *slot;
+	unsigned int i;
+
+	for (i = 0U; i < stats->num_slots; i++) {
+		if (stats->slots[i].fid == fid)
+			return &stats->slots[i];
+	}
+
+	/* Function IDs seen once all slots are in use are not tracked */
+	if (stats->num_slots == SMC_LAT_MAX_FIDS)
+		return NULL;
+
+	slot = &stats->slots[stats->num_slots];
+	slot->fid = fid;
+	slot->min = UINT64_MAX;
+	stats->num_slots++;
+
+	return slot;
+}
+
+/*******************************************************************************
+ * Account for an SMC that entered EL3 at counter value 'start'. Called by
+ * smc_handler64 once the handler has returned, on the runtime stack.
+ ******************************************************************************/
+void smc_lat_record(uint32_t smc_fid, uint64_t start)
+{
+	uint64_t delta = read_cntpct_el0() - start;
+	smc_lat_slot_t *slot;
+	unsigned int bucket;
+
+	slot = smc_lat_find_slot(&smc_lat_stats[plat_my_core_pos()], smc_fid);
+	if (slot == NULL)
+		return;
+
+	bucket = (delta == 0ULL) ? 0U : (64U - __builtin_clzll(delta));
+	if (bucket >= SMC_LAT_BUCKETS)
+		bucket = SMC_LAT_BUCKETS - 1U;
+
+	slot->buckets[bucket]++;
+	slot->count++;
+	if (delta < slot->min)
+		slot->min = delta;
+	if (delta > slot->max)
+		slot->max = delta;
+}
+
+/*******************************************************************************
+ * PMF get_ts handler: return the statistic selected by 'tid' for the CPU
+ * 'mpidr'. Unused slots read as 0.
+ ******************************************************************************/
+static unsigned long long smc_lat_get_stat(unsigned int tid,
+					   u_register_t mpidr,
+					   unsigned int flags)
+{
+	const smc_lat_stats_t *stats;
+	const smc_lat_slot_t *slot;
+	unsigned int id = tid & PMF_TID_MASK;
+	unsigned int idx = (tid >> SMC_LAT_SLOT_SHIFT) & SMC_LAT_SLOT_MASK;
+	int cpu = plat_core_pos_by_mpidr(mpidr);
+
+	(void)flags;
+
+	if (cpu < 0)
+		return 0ULL;
+
+	stats = &smc_lat_stats[cpu];
+	if (idx >= stats->num_slots)
+		return 0ULL;
+
+	slot = &stats->slots[idx];
+	switch (id) {
+	case SMC_LAT_FID:
+		return slot->fid;
+	case SMC_LAT_COUNT:
+		return slot->count;
+	case SMC_LAT_MIN:
+		return slot->min;
+	case SMC_LAT_MAX:
+		return slot->max;
+	default:
+		return slot->buckets[id - SMC_LAT_BUCKET0];
+	}
+}
@@ -37,6 +37,68 @@ struct frame_record {
 	uintptr_t return_addr;
 };
 
+#if ENABLE_BACKTRACE_SYMBOLS
+/*
+ * Symbol table generated at build time by gen_symtab.sh. It holds the
+ * functions of the image sorted by address, as offsets from the first one to
+ * keep it small. The table is also linked in position independent images, so
+ * the address of the first function is found at runtime from the address of
+ * backtrace() itself.
+ */
+struct backtrace_symtab {
+	/* Number of symbols in the table */
+	uint32_t count;
+	/* Offset of backtrace() */
+	uint32_t anchor;
+	/* Size of the range covered by the table */
+	uint32_t size;
+	uint32_t reserved;
+	/*
+	 * 'count' symbol offsets, followed by 'count' offsets of their names
+	 * in the string table, followed by the string table.
+	 */
+	uint32_t data[];
+};
+
+extern const struct backtrace_symtab backtrace_symtab;
+
+/*
+ * Returns the name of the function containing the specified address and the
+ * offset of the address in that function, or NULL if the address is not
+ * covered by the symbol table.
+ */
+static const char *find_symbol(uintptr_t addr, uintptr_t *offset)
+{
+	const struct backtrace_symtab *tab = &backtrace_symtab;
+	const uint32_t *sym_offs = &tab->data[0];
+	const uint32_t *name_offs = &tab->data[tab->count];
+	const char *strtab = (const char *)&tab->data[2U * tab->count];
+	uintptr_t base = (uintptr_t)&backtrace - tab->anchor;
+	uint32_t off;
+	unsigned int lo = 0U, hi = tab->count, mid;
+
+	if ((tab->count == 0U) || (addr < base) || ((addr - base) >= tab->size))
+		return NULL;
+
+	off = (uint32_t)(addr - base);
+
+	/*
+	 * Binary search for the last symbol at or below 'off'. The first
+	 * symbol is at offset 0, so there is always one.
+	 */
+	while ((hi - lo) > 1U) {
+		mid = lo + ((hi - lo) / 2U);
+		if (sym_offs[mid] <= off)
+			lo = mid;
+		else
+			hi = mid;
+	}
+
+	*offset = off - sym_offs[lo];
+	return &strtab[name_offs[lo]];
+}
+#endif /* ENABLE_BACKTRACE_SYMBOLS */
+
 static const char *get_el_str(unsigned int el)
 {
 	if (el == 3U) {
@@ -164,11 +226,28 @@ static struct frame_record *adjust_frame_record(struct frame_record *fr)
 #endif
 }
 
+static void print_backtrace_entry(unsigned int level, const char *el_str,
+				  uintptr_t addr)
+{
+#if ENABLE_BACKTRACE_SYMBOLS
+	const char *name;
+	uintptr_t offset;
+
+	name = find_symbol(addr, &offset);
+	if (name != NULL) {
+		printf("%u: %s: 0x%lx %s+0x%lx\n", level, el_str, addr, name,
+		       offset);
+		return;
+	}
+#endif
+
+	printf("%u: %s: 0x%lx\n", level, el_str, addr);
+}
+
 static void unwind_stack(struct frame_record *fr, uintptr_t current_pc,
 			 uintptr_t link_register)
 {
 	uintptr_t call_site;
-	static const char *backtrace_str = "%u: %s: 0x%lx\n";
 	const char *el_str = get_el_str(get_current_el());
 
 	if (!is_valid_frame_record(fr)) {
@@ -184,7 +263,7 @@ static void unwind_stack(struct frame_record *fr, uintptr_t current_pc,
 	}
 
 	/* The level 0 of the backtrace is the current backtrace function */
-	printf(backtrace_str, 0U, el_str, current_pc);
+	print_backtrace_entry(0U, el_str, current_pc);
 
 	/*
 	 * The last frame record pointer in the linked list at the beginning of
@@ -208,7 +287,7 @@ static void unwind_stack(struct frame_record *fr, uintptr_t current_pc,
 		if (!is_valid_jump_address(call_site))
 			return;
 
-		printf(backtrace_str, i, el_str, call_site);
+		print_backtrace_entry(i, el_str, call_site);
 
 		fr = adjust_frame_record(fr->parent);
 	}
@@ -228,11 +307,13 @@ static void unwind_stack(struct frame_record *fr, uintptr_t current_pc,
  * records on AArch64 and compliant with GCC-specific frame record format on
  * AArch32.
  *
- * Usage of the trace: addr2line can be used to map the addresses to function
- * and source code location when given the ELF file compiled with debug
- * information. The "-i" flag is highly recommended to improve display of
- * inlined function. The *.dump files generated when building each image can
- * also be used.
+ * Usage of the trace: if ENABLE_BACKTRACE_SYMBOLS is set, each address is
+ * followed by the name of the function containing it and the offset in that
+ * function. Otherwise, or to get the source code location, addr2line can be
+ * used to map the addresses to function and source code location when given
+ * the ELF file compiled with debug information. The "-i" flag is highly
+ * recommended to improve display of inlined function. The *.dump files
+ * generated when building each image can also be used.
  *
  * WARNING: In case of corrupted stack, this function could display security
  * sensitive information past the beginning of the stack so it must not be used
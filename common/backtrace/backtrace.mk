@@ -18,6 +18,18 @@ ifeq (${ENABLE_BACKTRACE},1)
         BL_COMMON_SOURCES	+=	common/backtrace/backtrace.c
 endif
 
+# Script generating the symbol table used by ENABLE_BACKTRACE_SYMBOLS
+BACKTRACE_SYMTAB_GEN	:=	common/backtrace/gen_symtab.sh
+
+ifeq (${ENABLE_BACKTRACE_SYMBOLS},1)
+        ifneq (${ENABLE_BACKTRACE},1)
+                $(error Error: ENABLE_BACKTRACE_SYMBOLS requires ENABLE_BACKTRACE=1)
+        endif
+        ifneq ($(findstring armlink,$(notdir $(LD))),)
+                $(error Error: ENABLE_BACKTRACE_SYMBOLS is not supported with armlink)
+        endif
+endif
+
 ifeq (${ARCH},aarch32)
         ifeq (${ENABLE_BACKTRACE},1)
                 ifneq (${AARCH32_INSTRUCTION_SET},A32)
@@ -28,4 +40,6 @@ ifeq (${ARCH},aarch32)
 endif
 
 $(eval $(call assert_boolean,ENABLE_BACKTRACE))
+$(eval $(call assert_boolean,ENABLE_BACKTRACE_SYMBOLS))
 $(eval $(call add_define,ENABLE_BACKTRACE))
+$(eval $(call add_define,ENABLE_BACKTRACE_SYMBOLS))
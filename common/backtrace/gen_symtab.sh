@@ -0,0 +1,127 @@
+#!/bin/sh
+# Copyright (c) 2019, ARM Limited and Contributors. All rights reserved.
+#
+# SPDX-License-Identifier: BSD-3-Clause
+
+# Generate the symbol table used by backtrace() to print function names.
+#
+# The input is the output of 'nm -S' run on a BL image, read from the files
+# given as arguments or from the standard input. The output is an assembly
+# file defining 'backtrace_symtab', which contains the functions of the image
+# sorted by address:
+#
+#	.word	number of symbols (N)
+#	.word	offset of backtrace() from the first symbol
+#	.word	size of the range covered by the table
+#	.word	reserved
+#	.word	N offsets of the symbols from the first symbol
+#	.word	N offsets of the names in the string table
+#	.asciz	string table
+#
+# An empty input generates an empty table.
+
+set -e
+
+output=backtrace_symtab.S
+
+while [ $# -gt 0 ]
+do
+	case $1 in
+	-o)
+		[ $# -ge 2 ] || {
+			echo usage: gen_symtab.sh [-o output] [file ...] >&2
+			exit 1
+		}
+		output=$2
+		shift 2
+		;;
+	--)
+		shift
+		break
+		;;
+	-*)
+		echo usage: gen_symtab.sh [-o output] [file ...] >&2
+		exit 1
+		;;
+	*)
+		break
+		;;
+	esac
+done
+
+tmp=`mktemp`
+trap "rm -f $tmp" EXIT INT QUIT
+
+# Keep the text symbols only, and drop mapping symbols and local labels
+cat "$@" |
+awk '
+NF == 4 {addr = $1; size = $2; type = $3; name = $4}
+NF == 3 {addr = $1; size = "-"; type = $2; name = $3}
+NF == 3 || NF == 4 {
+	if (type !~ /^[TtWw]$/ || name ~ /^\$/ || name ~ /^\.L/)
+		next
+	print addr, size, name
+}' |
+sort -k1,1 -k3,3 |
+awk '
+function hex(s,    i, v) {
+	v = 0
+	s = tolower(s)
+	for (i = 1; i <= length(s); i++)
+		v = v * 16 + index("0123456789abcdef", substr(s, i, 1)) - 1
+	return v
+}
+
+BEGIN {n = 0; end = 0}
+
+# Several symbols at the same address: keep the first one
+$1 == last {next}
+
+{
+	last = $1
+	addr[n] = hex($1)
+	name[n] = $3
+	if ($2 != "-" && addr[n] + hex($2) > end)
+		end = addr[n] + hex($2)
+	if (addr[n] > end)
+		end = addr[n]
+	if ($3 == "backtrace")
+		anchor = n
+	n++
+}
+
+END {
+	if (n > 0 && anchor == "") {
+		print "gen_symtab.sh: backtrace() not found" > "/dev/stderr"
+		exit 1
+	}
+
+	print "/* Generated by gen_symtab.sh, do not edit */"
+	print ""
+	print "\t.section\t.rodata.backtrace_symtab, \"a\""
+	print "\t.globl\tbacktrace_symtab"
+	print "\t.align\t2"
+	print "backtrace_symtab:"
+
+	if (n == 0) {
+		print "\t.word\t0, 0, 0, 0"
+		exit 0
+	}
+
+	base = addr[0]
+	printf "\t.word\t%d, 0x%x, 0x%x, 0\n", n, addr[anchor] - base, end - base
+
+	for (i = 0; i < n; i++)
+		printf "\t.word\t0x%x\n", addr[i] - base
+
+	off = 0
+	for (i = 0; i < n; i++) {
+		printf "\t.word\t0x%x\n", off
+		off += length(name[i]) + 1
+	}
+
+	for (i = 0; i < n; i++)
+		printf "\t.asciz\t\"%s\"\n", name[i]
+}' > $tmp
+
+mv $tmp $output
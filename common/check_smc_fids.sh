@@ -0,0 +1,85 @@
+#!/bin/sh
+# Copyright (c) 2019, ARM Limited and Contributors. All rights reserved.
+#
+# SPDX-License-Identifier: BSD-3-Clause
+
+# Check that no SMC function ID is registered twice with DECLARE_RT_SVC_FID()
+# in a BL image.
+#
+# The 'rt_svc_fid_desc_t' structures are collected by the linker between
+# __RT_SVC_FIDS_START__ and __RT_SVC_FIDS_END__. The function ID is the first
+# word of each structure, stored in little endian. Images without these
+# symbols are ignored.
+
+set -e
+
+if test $# -ne 4
+then
+	echo usage: check_smc_fids.sh nm objdump entry_size elf >&2
+	exit 1
+fi
+
+nm=$1
+objdump=$2
+size=$3
+elf=$4
+
+start=`$nm $elf | awk '$3 == "__RT_SVC_FIDS_START__" {print $1}'`
+end=`$nm $elf | awk '$3 == "__RT_SVC_FIDS_END__" {print $1}'`
+
+if test -z "$start" || test -z "$end" || test "$start" = "$end"
+then
+	exit 0
+fi
+
+$objdump -s --start-address=0x$start --stop-address=0x$end $elf |
+awk -v start=$start -v end=$end -v size=$size -v elf=$elf '
+function hex(s,    i, v) {
+	v = 0
+	s = tolower(s)
+	for (i = 1; i <= length(s); i++)
+		v = v * 16 + index("0123456789abcdef", substr(s, i, 1)) - 1
+	return v
+}
+
+BEGIN {
+	len = hex(end) - hex(start)
+	if (len % size != 0) {
+		printf "check_smc_fids.sh: %s: bad table size 0x%x\n", \
+			elf, len > "/dev/stderr"
+		failed = 1
+		exit 1
+	}
+	data = ""
+}
+
+# Each line holds up to 4 groups of 4 bytes after the address, followed by
+# their ASCII representation, which must not be parsed.
+/^ [0-9a-f]+ / {
+	for (i = 2; i <= 5 && length(data) < len * 2; i++)
+		data = data $i
+}
+
+END {
+	if (failed)
+		exit 1
+
+	if (length(data) != len * 2) {
+		printf "check_smc_fids.sh: %s: cannot read the table\n", \
+			elf > "/dev/stderr"
+		exit 1
+	}
+
+	for (off = 0; off < len; off += size) {
+		b = substr(data, off * 2 + 1, 8)
+		fid = substr(b, 7, 2) substr(b, 5, 2) substr(b, 3, 2) \
+			substr(b, 1, 2)
+		if (fid in seen) {
+			printf "check_smc_fids.sh: %s: SMC function ID 0x%s " \
+				"registered more than once\n", \
+				elf, fid > "/dev/stderr"
+			exit 1
+		}
+		seen[fid] = 1
+	}
+}'
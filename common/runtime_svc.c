@@ -25,6 +25,106 @@ uint8_t rt_svc_descs_indices[MAX_RT_SVCS];
 #define RT_SVC_DECS_NUM		((RT_SVC_DESCS_END - RT_SVC_DESCS_START)\
 					/ sizeof(rt_svc_desc_t))
 
+#if SMC_FID_DISPATCH
+/*******************************************************************************
+ * Function IDs with a dedicated handler, declared with DECLARE_RT_SVC_FID().
+ * 'rt_svc_fids' holds the function IDs sorted in ascending order, so that they
+ * can be searched with a binary search when an SMC arrives.
+ * 'rt_svc_fid_handles' and 'rt_svc_fid_flags' hold the corresponding handlers
+ * and flags.
+ ******************************************************************************/
+unsigned int rt_svc_fids_num;
+uint32_t rt_svc_fids[MAX_RT_SVC_FIDS];
+rt_svc_handle_t rt_svc_fid_handles[MAX_RT_SVC_FIDS];
+uint8_t rt_svc_fid_flags[MAX_RT_SVC_FIDS];
+
+#define RT_SVC_FID_DESCS_NUM	((RT_SVC_FIDS_END - RT_SVC_FIDS_START)\
+					/ sizeof(rt_svc_fid_desc_t))
+
+/*******************************************************************************
+ * Return the dedicated handler of a function ID, or NULL if there isn't one.
+ ******************************************************************************/
+static rt_svc_handle_t rt_svc_fid_lookup(uint32_t smc_fid)
+{
+	unsigned int lo = 0U, hi = rt_svc_fids_num, mid;
+
+	while (lo < hi) {
+		mid = (lo + hi) / 2U;
+		if (rt_svc_fids[mid] == smc_fid)
+			return rt_svc_fid_handles[mid];
+		if (rt_svc_fids[mid] > smc_fid)
+			hi = mid;
+		else
+			lo = mid + 1U;
+	}
+
+	return NULL;
+}
+
+/*******************************************************************************
+ * Build the sorted table of function IDs with a dedicated handler. The build
+ * system already checks that no function ID is declared twice, but the table
+ * is checked again here. Handlers of function IDs whose owning runtime
+ * service isn't available are left out.
+ ******************************************************************************/
+static void __init rt_svc_fids_init(void)
+{
+	const rt_svc_fid_desc_t *descs;
+	unsigned int i, j;
+	uint32_t fid;
+
+	assert((RT_SVC_FIDS_END >= RT_SVC_FIDS_START) &&
+	       (RT_SVC_FID_DESCS_NUM <= MAX_RT_SVC_FIDS));
+
+	descs = (const rt_svc_fid_desc_t *)RT_SVC_FIDS_START;
+	rt_svc_fids_num = 0U;
+
+	for (i = 0U; i < RT_SVC_FID_DESCS_NUM; i++) {
+		fid = descs[i].smc_fid;
+
+		if (descs[i].handle == NULL) {
+			ERROR("Invalid handler for SMC function ID 0x%x\n",
+			      fid);
+			panic();
+		}
+
+		/* Only fast SMC handlers can be called as leaf handlers */
+		if (((descs[i].flags & ~RT_SVC_FLAG_LEAF) != 0U) ||
+		    (((descs[i].flags & RT_SVC_FLAG_LEAF) != 0U) &&
+		     (GET_SMC_TYPE(fid) != SMC_TYPE_FAST))) {
+			ERROR("Invalid flags for SMC function ID 0x%x\n",
+			      fid);
+			panic();
+		}
+
+		if (rt_svc_descs_indices[get_unique_oen_from_smc_fid(fid)] >=
+		    RT_SVC_DECS_NUM)
+			continue;
+
+		/* Insertion sort, the table is small */
+		for (j = rt_svc_fids_num; j > 0U; j--) {
+			if (rt_svc_fids[j - 1U] < fid)
+				break;
+
+			if (rt_svc_fids[j - 1U] == fid) {
+				ERROR("SMC function ID 0x%x declared twice\n",
+				      fid);
+				panic();
+			}
+
+			rt_svc_fids[j] = rt_svc_fids[j - 1U];
+			rt_svc_fid_handles[j] = rt_svc_fid_handles[j - 1U];
+			rt_svc_fid_flags[j] = rt_svc_fid_flags[j - 1U];
+		}
+
+		rt_svc_fids[j] = fid;
+		rt_svc_fid_handles[j] = descs[i].handle;
+		rt_svc_fid_flags[j] = descs[i].flags;
+		rt_svc_fids_num++;
+	}
+}
+#endif /* SMC_FID_DISPATCH */
+
 /*******************************************************************************
  * Function to invoke the registered `handle` corresponding to the smc_fid in
  * AArch32 mode.
@@ -38,8 +138,21 @@ uintptr_t handle_runtime_svc(uint32_t smc_fid,
 	unsigned int index;
 	unsigned int idx;
 	const rt_svc_desc_t *rt_svc_descs;
+#if SMC_FID_DISPATCH
+	rt_svc_handle_t fid_handle;
+#endif
 
 	assert(handle != NULL);
+
+#if SMC_FID_DISPATCH
+	fid_handle = rt_svc_fid_lookup(smc_fid);
+	if (fid_handle != NULL) {
+		get_smc_params_from_ctx(handle, x1, x2, x3, x4);
+		return fid_handle(smc_fid, x1, x2, x3, x4, cookie, handle,
+				  flags);
+	}
+#endif
+
 	idx = get_unique_oen_from_smc_fid(smc_fid);
 	assert(idx < MAX_RT_SVCS);
 
@@ -77,6 +190,14 @@ static int32_t validate_rt_svc_desc(const rt_svc_desc_t *desc)
 	if ((desc->init == NULL) && (desc->handle == NULL))
 		return -EINVAL;
 
+	if ((desc->flags & ~RT_SVC_FLAG_LEAF) != 0U)
+		return -EINVAL;
+
+	/* Only fast SMC handlers can be called as leaf handlers */
+	if (((desc->flags & RT_SVC_FLAG_LEAF) != 0U) &&
+	    ((desc->call_type != SMC_TYPE_FAST) || (desc->handle == NULL)))
+		return -EINVAL;
+
 	return 0;
 }
 
@@ -151,4 +272,8 @@ void __init runtime_svc_init(void)
 		for (; start_idx <= end_idx; start_idx++)
 			rt_svc_descs_indices[start_idx] = index;
 	}
+
+#if SMC_FID_DISPATCH
+	rt_svc_fids_init();
+#endif
 }
@@ -1,5 +1,5 @@
 /*
- * Copyright (c) 2017-2018, ARM Limited and Contributors. All rights reserved.
+ * Copyright (c) 2017-2019, ARM Limited and Contributors. All rights reserved.
  *
  * SPDX-License-Identifier: BSD-3-Clause
  */
@@ -14,6 +14,19 @@
 /* Set the default maximum log level to the `LOG_LEVEL` build flag */
 static unsigned int max_log_level = LOG_LEVEL;
 
+/* Categories enabled for INFO and VERBOSE output, all by default */
+static unsigned int log_categories = LOG_CAT_ALL;
+
+/* Value of tf_log_filter for a maximum log level and a set of categories */
+#define LOG_FILTER(level, cats)						\
+	((((level) >= LOG_LEVEL_INFO) ?					\
+	  ((cats) << LOG_FILTER_INFO_SHIFT) : 0U) |			\
+	 (((level) >= LOG_LEVEL_VERBOSE) ?				\
+	  ((cats) << LOG_FILTER_VERBOSE_SHIFT) : 0U))
+
+/* Runtime filter checked by the INFO and VERBOSE macros, see debug.h */
+unsigned int tf_log_filter = LOG_FILTER(LOG_LEVEL, LOG_CAT_ALL);
+
 /*
  * The common log function which is invoked by ARM Trusted Firmware code.
  * This function should not be directly invoked and is meant to be
@@ -60,6 +73,21 @@ void tf_log_set_max_level(unsigned int log_level)
 	assert((log_level % 10U) == 0U);
 
 	/* Cap log_level to the compile time maximum. */
-	if (log_level <= (unsigned int)LOG_LEVEL)
+	if (log_level <= (unsigned int)LOG_LEVEL) {
 		max_log_level = log_level;
+		tf_log_filter = LOG_FILTER(max_log_level, log_categories);
+	}
+}
+
+/*
+ * The helper function to select the categories of INFO and VERBOSE log output
+ * dynamically. `categories` is a mask of LOG_CAT_BIT() values. Output of other
+ * levels is not affected.
+ */
+void tf_log_set_categories(unsigned int categories)
+{
+	assert((categories & ~LOG_CAT_ALL) == 0U);
+
+	log_categories = categories;
+	tf_log_filter = LOG_FILTER(max_log_level, log_categories);
 }
@@ -4,6 +4,8 @@
  * SPDX-License-Identifier: BSD-3-Clause
  */
 
+#define LOG_CATEGORY	LOG_CAT_AUTH
+
 #include <stddef.h>
 #include <string.h>
 
@@ -87,6 +87,47 @@ int console_putc(int c)
 	return err;
 }
 
+/*
+ * Fallback for consoles that don't implement puts(). Returns 'len' on success
+ * or the error returned by putc().
+ */
+static int console_putc_each(const char *str, size_t len, console_t *console)
+{
+	size_t i;
+
+	for (i = 0U; i < len; i++) {
+		int ret = console->putc(str[i], console);
+		if (ret < 0)
+			return ret;
+	}
+
+	return (int)len;
+}
+
+int console_puts(const char *str, size_t len)
+{
+	int err = ERROR_NO_VALID_CONSOLE;
+	console_t *console;
+	int ret;
+
+	for (console = console_list; console != NULL; console = console->next) {
+		if ((console->flags & console_state) == 0U)
+			continue;
+
+		if (console->puts)
+			ret = console->puts(str, len, console);
+		else if (console->putc)
+			ret = console_putc_each(str, len, console);
+		else
+			continue;
+
+		if ((err == ERROR_NO_VALID_CONSOLE) || (ret < err))
+			err = ret;
+	}
+
+	return err;
+}
+
 int console_getc(void)
 {
 	int err = ERROR_NO_VALID_CONSOLE;
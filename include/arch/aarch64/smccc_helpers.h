@@ -11,6 +11,7 @@
 
 #ifndef __ASSEMBLY__
 
+#include <assert.h>
 #include <stdbool.h>
 
 #include <context.h>
@@ -70,6 +71,43 @@
 #define SMC_SET_EL3(_h, _e, _v)					\
 	write_ctx_reg((get_el3state_ctx(_h)), (_e), (_v))
 
+/*
+ * Helper macros to access the SMCCC v1.2 arguments and results, x0 - x17,
+ * using an array. get_smc_regs_from_ctx() reads SMCCC_GP_REGS_NUM registers,
+ * SMC_RET_REGS() returns the first '_num' registers of the array.
+ */
+#define get_smc_regs_from_ctx(_hdl, _arr)				\
+	do {								\
+		const gp_regs_t *_ctx_regs = get_gpregs_ctx(_hdl);	\
+		unsigned int _i;					\
+		for (_i = 0U; _i < SMCCC_GP_REGS_NUM; _i++)		\
+			(_arr)[_i] = _ctx_regs->_regs[_i];		\
+	} while (false)
+
+#define SMC_RET_REGS(_h, _arr, _num)	{				\
+	gp_regs_t *_ctx_regs = get_gpregs_ctx(_h);			\
+	unsigned int _i;						\
+	assert((_num) <= SMCCC_GP_REGS_NUM);				\
+	for (_i = 0U; _i < (_num); _i++)				\
+		_ctx_regs->_regs[_i] = (_arr)[_i];			\
+	SMC_RET0(_h);							\
+}
+
+/*
+ * Copy the '_num' registers from x'_src_reg' of the context '_src' to
+ * x'_dst_reg' onwards of the context '_dst'. This is used by dispatchers to
+ * pass SMCCC v1.2 arguments and results between two worlds.
+ */
+#define smc_copy_gp_regs(_dst, _dst_reg, _src, _src_reg, _num)		\
+	do {								\
+		unsigned int _i;					\
+		assert(((_dst_reg) + (_num)) <= SMCCC_GP_REGS_NUM);	\
+		assert(((_src_reg) + (_num)) <= SMCCC_GP_REGS_NUM);	\
+		for (_i = 0U; _i < (_num); _i++)			\
+			get_gpregs_ctx(_dst)->_regs[(_dst_reg) + _i] =	\
+				get_gpregs_ctx(_src)->_regs[(_src_reg) + _i]; \
+	} while (false)
+
 /*
  * Helper macro to retrieve the SMC parameters from cpu_context_t.
  */
@@ -0,0 +1,135 @@
+/*
+ * Copyright (c) 2019, ARM Limited and Contributors. All rights reserved.
+ *
+ * SPDX-License-Identifier: BSD-3-Clause
+ */
+
+#ifndef CRASH_DUMP_H
+#define CRASH_DUMP_H
+
+#include <platform_def.h>	/* CACHE_WRITEBACK_GRANULE required */
+
+#include <context.h>
+#include <lib/utils_def.h>
+
+/*******************************************************************************
+ * Layout of the per-CPU crash dump record. The record is filled in by
+ * crash_dump_capture() without a stack, so the offsets below are shared
+ * between assembler and C code.
+ *
+ * The checksum is the 64-bit sum of every double word from
+ * CRASH_DUMP_DATA_OFFSET up to the end of the record. The magic is written
+ * last, so a record with a matching magic and checksum is complete.
+ ******************************************************************************/
+#define CRASH_DUMP_MAGIC		ULL(0x504d554448535243)	/* "CRSHDUMP" */
+
+#define CRASH_DUMP_STATUS_NEW		U(0x1)
+#define CRASH_DUMP_STATUS_REPORTED	U(0x2)
+
+#define CRASH_DUMP_MAGIC_OFFSET		U(0x0)
+#define CRASH_DUMP_CHECKSUM_OFFSET	U(0x8)
+#define CRASH_DUMP_STATUS_OFFSET	U(0x10)
+#define CRASH_DUMP_DATA_OFFSET		U(0x20)
+#define CRASH_DUMP_MPIDR_OFFSET		CRASH_DUMP_DATA_OFFSET
+#define CRASH_DUMP_TIMESTAMP_OFFSET	(CRASH_DUMP_DATA_OFFSET + U(0x8))
+
+/* x0 - x30 and SP_EL0, using the same layout as the 'gp_regs' structure */
+#define CRASH_DUMP_GPREGS_OFFSET	(CRASH_DUMP_DATA_OFFSET + U(0x10))
+
+/* EL3 system registers, in this order. Aligned to the next 16 byte boundary */
+#define CRASH_DUMP_EL3REGS_OFFSET	(CRASH_DUMP_GPREGS_OFFSET + CTX_GPREGS_END)
+#define CRASH_DUMP_SCR_EL3		U(0x0)
+#define CRASH_DUMP_SCTLR_EL3		U(0x8)
+#define CRASH_DUMP_CPTR_EL3		U(0x10)
+#define CRASH_DUMP_TCR_EL3		U(0x18)
+#define CRASH_DUMP_DAIF			U(0x20)
+#define CRASH_DUMP_MAIR_EL3		U(0x28)
+#define CRASH_DUMP_SPSR_EL3		U(0x30)
+#define CRASH_DUMP_ELR_EL3		U(0x38)
+#define CRASH_DUMP_TTBR0_EL3		U(0x40)
+#define CRASH_DUMP_ESR_EL3		U(0x48)
+#define CRASH_DUMP_FAR_EL3		U(0x50)
+#define CRASH_DUMP_EL3REGS_END		U(0x60)
+
+/*
+ * Lower EL system registers, in the order they are reported by the crash
+ * console (spsr_el1 ... isr_el1), leaving out mpidr_el1 and sp_el0 which are
+ * already part of the record. Aligned to the next 16 byte boundary.
+ */
+#define CRASH_DUMP_EL1REGS_OFFSET	(CRASH_DUMP_EL3REGS_OFFSET + \
+					 CRASH_DUMP_EL3REGS_END)
+#define CRASH_DUMP_EL1REGS_NUM		U(33)
+#define CRASH_DUMP_EL1REGS_END		U(0x110)
+
+/* Call sites found by walking the frame records, zero terminated */
+#define CRASH_DUMP_BT_OFFSET		(CRASH_DUMP_EL1REGS_OFFSET + \
+					 CRASH_DUMP_EL1REGS_END)
+#define CRASH_DUMP_BT_DEPTH		U(16)
+#define CRASH_DUMP_BT_END		(CRASH_DUMP_BT_DEPTH * U(8))
+
+/*
+ * Copies of the Secure and Non-secure 'cpu_context' structures, aligned to the
+ * next cache writeback granule like the structures themselves
+ */
+#define CRASH_DUMP_CTX_SIZE		CTX_SIZE
+#define CRASH_DUMP_CTX_OFFSET		(((CRASH_DUMP_BT_OFFSET + \
+					CRASH_DUMP_BT_END + \
+					CACHE_WRITEBACK_GRANULE - 1) / \
+						CACHE_WRITEBACK_GRANULE) * \
+							CACHE_WRITEBACK_GRANULE)
+#define CRASH_DUMP_CTX_END		(CRASH_DUMP_CTX_SIZE * U(2))
+
+#define CRASH_DUMP_DATA_END		(CRASH_DUMP_CTX_OFFSET + \
+					 CRASH_DUMP_CTX_END)
+
+/* Each record is rounded up to the platform cache line size */
+#define CRASH_DUMP_REC_SIZE		(((CRASH_DUMP_DATA_END + \
+					CACHE_WRITEBACK_GRANULE - 1) / \
+						CACHE_WRITEBACK_GRANULE) * \
+							CACHE_WRITEBACK_GRANULE)
+
+#ifndef __ASSEMBLY__
+
+#include <stdint.h>
+
+#include <lib/cassert.h>
+
+typedef struct crash_dump_rec {
+	uint64_t magic;
+	uint64_t checksum;
+	uint64_t status;
+	uint64_t reserved;
+	uint64_t mpidr;
+	uint64_t timestamp;
+	gp_regs_t gpregs;
+	uint64_t el3_regs[CRASH_DUMP_EL3REGS_END >> DWORD_SHIFT];
+	uint64_t el1_regs[CRASH_DUMP_EL1REGS_END >> DWORD_SHIFT];
+	uint64_t backtrace[CRASH_DUMP_BT_DEPTH];
+	cpu_context_t ctx[2];
+} __aligned(CACHE_WRITEBACK_GRANULE) crash_dump_rec_t;
+
+CASSERT(CRASH_DUMP_MPIDR_OFFSET == __builtin_offsetof(crash_dump_rec_t, mpidr),
+	assert_crash_dump_mpidr_offset_mismatch);
+CASSERT(CRASH_DUMP_GPREGS_OFFSET == __builtin_offsetof(crash_dump_rec_t, gpregs),
+	assert_crash_dump_gpregs_offset_mismatch);
+CASSERT(CRASH_DUMP_EL3REGS_OFFSET ==
+	__builtin_offsetof(crash_dump_rec_t, el3_regs),
+	assert_crash_dump_el3regs_offset_mismatch);
+CASSERT(CRASH_DUMP_EL1REGS_OFFSET ==
+	__builtin_offsetof(crash_dump_rec_t, el1_regs),
+	assert_crash_dump_el1regs_offset_mismatch);
+CASSERT(CRASH_DUMP_BT_OFFSET == __builtin_offsetof(crash_dump_rec_t, backtrace),
+	assert_crash_dump_bt_offset_mismatch);
+CASSERT(CRASH_DUMP_CTX_OFFSET == __builtin_offsetof(crash_dump_rec_t, ctx),
+	assert_crash_dump_ctx_offset_mismatch);
+CASSERT(CRASH_DUMP_CTX_SIZE == sizeof(cpu_context_t),
+	assert_crash_dump_ctx_size_mismatch);
+CASSERT(CRASH_DUMP_REC_SIZE == sizeof(crash_dump_rec_t),
+	assert_crash_dump_rec_size_mismatch);
+
+void crash_dump_init(void);
+const crash_dump_rec_t *crash_dump_get(unsigned int core_pos);
+
+#endif /* __ASSEMBLY__ */
+
+#endif /* CRASH_DUMP_H */
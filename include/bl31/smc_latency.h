@@ -0,0 +1,43 @@
+/*
+ * Copyright (c) 2019, ARM Limited and Contributors. All rights reserved.
+ *
+ * SPDX-License-Identifier: BSD-3-Clause
+ */
+
+#ifndef SMC_LATENCY_H
+#define SMC_LATENCY_H
+
+#include <lib/utils_def.h>
+
+/*******************************************************************************
+ * Per-CPU SMC latency statistics. Each CPU tracks up to SMC_LAT_MAX_FIDS
+ * function IDs, in the order they are first seen. Bucket 'n' of the histogram
+ * counts the calls that took [2^(n-1), 2^n) counter ticks, the last bucket
+ * also counts every longer call.
+ *
+ * The statistics are read through the PMF SMC interface with the service ID
+ * PMF_SMC_LAT_SVC_ID. Bits [7:0] of the timer ID select one of the values
+ * below and bits [23:16] select the slot, the MPIDR selects the CPU.
+ ******************************************************************************/
+#define SMC_LAT_MAX_FIDS		U(16)
+#define SMC_LAT_BUCKETS			U(16)
+
+#define SMC_LAT_FID			U(0)
+#define SMC_LAT_COUNT			U(1)
+#define SMC_LAT_MIN			U(2)
+#define SMC_LAT_MAX			U(3)
+#define SMC_LAT_BUCKET0			U(4)
+#define SMC_LAT_TOTAL_IDS		(SMC_LAT_BUCKET0 + SMC_LAT_BUCKETS)
+
+#define SMC_LAT_SLOT_SHIFT		U(16)
+#define SMC_LAT_SLOT_MASK		U(0xFF)
+
+#ifndef __ASSEMBLY__
+
+#include <stdint.h>
+
+void smc_lat_record(uint32_t smc_fid, uint64_t start);
+
+#endif /* __ASSEMBLY__ */
+
+#endif /* SMC_LATENCY_H */
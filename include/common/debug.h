@@ -1,5 +1,5 @@
 /*
- * Copyright (c) 2013-2018, ARM Limited and Contributors. All rights reserved.
+ * Copyright (c) 2013-2019, ARM Limited and Contributors. All rights reserved.
  *
  * SPDX-License-Identifier: BSD-3-Clause
  */
@@ -18,6 +18,14 @@
  * The format expected is the same as for printf(). For example:
  * INFO("Info %s.\n", "message")    -> INFO:    Info message.
  * WARN("Warning %s.\n", "message") -> WARNING: Warning message.
+ *
+ * Log output is also filtered by category. A source file selects its category
+ * by defining LOG_CATEGORY to one of the LOG_CAT_* values below before
+ * including any header, otherwise it uses LOG_CAT_GENERIC. Each category has
+ * its own compile time log level, LOG_LEVEL_<category>, which defaults to
+ * LOG_LEVEL and can only lower it. INFO and VERBOSE output can additionally
+ * be enabled per category at runtime with tf_log_set_categories(). That check
+ * is done inline, before the arguments are evaluated.
  */
 
 #define LOG_LEVEL_NONE			U(0)
@@ -47,6 +55,66 @@
 #define LOG_MARKER_INFO			"\x28"	/* 40 */
 #define LOG_MARKER_VERBOSE		"\x32"	/* 50 */
 
+/* Log categories */
+#define LOG_CAT_GENERIC			U(0)
+#define LOG_CAT_PSCI			U(1)
+#define LOG_CAT_SDEI			U(2)
+#define LOG_CAT_SPM			U(3)
+#define LOG_CAT_IO			U(4)
+#define LOG_CAT_AUTH			U(5)
+#define LOG_CAT_XLAT			U(6)
+#define LOG_CAT_GIC			U(7)
+#define LOG_CAT_MAX			LOG_CAT_GIC
+
+#define LOG_CAT_BIT(cat)		(U(1) << (cat))
+#define LOG_CAT_ALL			(LOG_CAT_BIT(LOG_CAT_MAX + U(1)) - U(1))
+
+#ifndef LOG_CATEGORY
+# define LOG_CATEGORY			LOG_CAT_GENERIC
+#endif
+
+#ifndef LOG_LEVEL_PSCI
+# define LOG_LEVEL_PSCI			LOG_LEVEL
+#endif
+#ifndef LOG_LEVEL_SDEI
+# define LOG_LEVEL_SDEI			LOG_LEVEL
+#endif
+#ifndef LOG_LEVEL_SPM
+# define LOG_LEVEL_SPM			LOG_LEVEL
+#endif
+#ifndef LOG_LEVEL_IO
+# define LOG_LEVEL_IO			LOG_LEVEL
+#endif
+#ifndef LOG_LEVEL_AUTH
+# define LOG_LEVEL_AUTH			LOG_LEVEL
+#endif
+#ifndef LOG_LEVEL_XLAT
+# define LOG_LEVEL_XLAT			LOG_LEVEL
+#endif
+#ifndef LOG_LEVEL_GIC
+# define LOG_LEVEL_GIC			LOG_LEVEL
+#endif
+
+/* Compile time log level of a category, evaluated by the compiler */
+#define LOG_CAT_LEVEL(cat)					\
+	(((cat) == LOG_CAT_PSCI) ? LOG_LEVEL_PSCI :		\
+	 ((cat) == LOG_CAT_SDEI) ? LOG_LEVEL_SDEI :		\
+	 ((cat) == LOG_CAT_SPM)  ? LOG_LEVEL_SPM :		\
+	 ((cat) == LOG_CAT_IO)   ? LOG_LEVEL_IO :		\
+	 ((cat) == LOG_CAT_AUTH) ? LOG_LEVEL_AUTH :		\
+	 ((cat) == LOG_CAT_XLAT) ? LOG_LEVEL_XLAT :		\
+	 ((cat) == LOG_CAT_GIC)  ? LOG_LEVEL_GIC : LOG_LEVEL)
+
+/*
+ * Runtime filter for INFO and VERBOSE output. Each of these log levels has a
+ * bit per category in 'tf_log_filter', which is set if the category is
+ * enabled and the level is not above the runtime maximum log level.
+ */
+#define LOG_FILTER_INFO_SHIFT		U(0)
+#define LOG_FILTER_VERBOSE_SHIFT	U(16)
+
+extern unsigned int tf_log_filter;
+
 /*
  * If the log output is too low then this macro is used in place of tf_log()
  * below. The intent is to get the compiler to evaluate the function call for
@@ -59,32 +127,57 @@
 		}					\
 	} while (false)
 
+/*
+ * Log output of a level that is compiled in. The category check is a
+ * compile time constant, which lets the compiler remove the call if the
+ * category log level is too low.
+ */
+#define cat_tf_log(level, fmt, ...)					\
+	do {								\
+		if (LOG_CAT_LEVEL(LOG_CATEGORY) >= (level)) {		\
+			tf_log(fmt, ##__VA_ARGS__);			\
+		}							\
+	} while (false)
+
+/* Same as cat_tf_log(), also checking the runtime filter */
+#define filtered_tf_log(level, shift, fmt, ...)				\
+	do {								\
+		if ((LOG_CAT_LEVEL(LOG_CATEGORY) >= (level)) &&		\
+		    ((tf_log_filter &					\
+		      (LOG_CAT_BIT(LOG_CATEGORY) << (shift))) != 0U)) {	\
+			tf_log(fmt, ##__VA_ARGS__);			\
+		}							\
+	} while (false)
+
 #if LOG_LEVEL >= LOG_LEVEL_ERROR
-# define ERROR(...)	tf_log(LOG_MARKER_ERROR __VA_ARGS__)
+# define ERROR(...)	cat_tf_log(LOG_LEVEL_ERROR, LOG_MARKER_ERROR __VA_ARGS__)
 #else
 # define ERROR(...)	no_tf_log(LOG_MARKER_ERROR __VA_ARGS__)
 #endif
 
 #if LOG_LEVEL >= LOG_LEVEL_NOTICE
-# define NOTICE(...)	tf_log(LOG_MARKER_NOTICE __VA_ARGS__)
+# define NOTICE(...)	cat_tf_log(LOG_LEVEL_NOTICE, LOG_MARKER_NOTICE __VA_ARGS__)
 #else
 # define NOTICE(...)	no_tf_log(LOG_MARKER_NOTICE __VA_ARGS__)
 #endif
 
 #if LOG_LEVEL >= LOG_LEVEL_WARNING
-# define WARN(...)	tf_log(LOG_MARKER_WARNING __VA_ARGS__)
+# define WARN(...)	cat_tf_log(LOG_LEVEL_WARNING, LOG_MARKER_WARNING __VA_ARGS__)
 #else
 # define WARN(...)	no_tf_log(LOG_MARKER_WARNING __VA_ARGS__)
 #endif
 
 #if LOG_LEVEL >= LOG_LEVEL_INFO
-# define INFO(...)	tf_log(LOG_MARKER_INFO __VA_ARGS__)
+# define INFO(...)	filtered_tf_log(LOG_LEVEL_INFO, LOG_FILTER_INFO_SHIFT, \
+					LOG_MARKER_INFO __VA_ARGS__)
 #else
 # define INFO(...)	no_tf_log(LOG_MARKER_INFO __VA_ARGS__)
 #endif
 
 #if LOG_LEVEL >= LOG_LEVEL_VERBOSE
-# define VERBOSE(...)	tf_log(LOG_MARKER_VERBOSE __VA_ARGS__)
+# define VERBOSE(...)	filtered_tf_log(LOG_LEVEL_VERBOSE,		\
+					LOG_FILTER_VERBOSE_SHIFT,	\
+					LOG_MARKER_VERBOSE __VA_ARGS__)
 #else
 # define VERBOSE(...)	no_tf_log(LOG_MARKER_VERBOSE __VA_ARGS__)
 #endif
@@ -109,6 +202,7 @@ void __dead2 __stack_chk_fail(void);
 
 void tf_log(const char *fmt, ...) __printflike(1, 2);
 void tf_log_set_max_level(unsigned int log_level);
+void tf_log_set_categories(unsigned int categories);
 
 #endif /* __ASSEMBLY__ */
 #endif /* DEBUG_H */
@@ -20,6 +20,7 @@
  * Constants to allow the assembler access a runtime service
  * descriptor
  */
+#define RT_SVC_DESC_FLAGS	U(3)
 #ifdef AARCH32
 #define RT_SVC_SIZE_LOG2	U(4)
 #define RT_SVC_DESC_INIT	U(8)
@@ -31,6 +32,22 @@
 #endif /* AARCH32 */
 #define SIZEOF_RT_SVC_DESC	(U(1) << RT_SVC_SIZE_LOG2)
 
+/*
+ * Runtime service descriptor flags.
+ *
+ * RT_SVC_FLAG_LEAF marks a service whose fast SMC handler only reads the SMC
+ * arguments, writes its results with SMC_RET0 - SMC_RET4 and returns, without
+ * switching worlds, saving or restoring the EL1 system registers, modifying
+ * the EL3 state of the context or reading the callee-saved registers (x19 -
+ * x29 and SP_EL0) saved in it. On AArch64, such handlers are called after
+ * saving x0 - x18 only, and return without going through el3_exit.
+ */
+#define RT_SVC_FLAG_LEAF_SHIFT	U(0)
+#define RT_SVC_FLAG_LEAF	(U(1) << RT_SVC_FLAG_LEAF_SHIFT)
+
+
+/* Maximum number of function IDs with a dedicated handler */
+#define MAX_RT_SVC_FIDS		U(32)
 
 /*
  * In SMCCC 1.X, the function identifier has 6 bits for the owning entity number
@@ -62,6 +79,7 @@ typedef struct rt_svc_desc {
 	uint8_t start_oen;
 	uint8_t end_oen;
 	uint8_t call_type;
+	uint8_t flags;
 	const char *name;
 	rt_svc_init_t init;
 	rt_svc_handle_t handle;
@@ -70,17 +88,46 @@ typedef struct rt_svc_desc {
 /*
  * Convenience macros to declare a service descriptor
  */
-#define DECLARE_RT_SVC(_name, _start, _end, _type, _setup, _smch)	\
+#define DECLARE_RT_SVC_FLAGS(_name, _start, _end, _type, _flags, _setup,	\
+			     _smch)					\
 	static const rt_svc_desc_t __svc_desc_ ## _name			\
 		__section("rt_svc_descs") __used = {			\
 			.start_oen = (_start),				\
 			.end_oen = (_end),				\
 			.call_type = (_type),				\
+			.flags = (_flags),				\
 			.name = #_name,					\
 			.init = (_setup),				\
 			.handle = (_smch)				\
 		}
 
+#define DECLARE_RT_SVC(_name, _start, _end, _type, _setup, _smch)	\
+	DECLARE_RT_SVC_FLAGS(_name, _start, _end, _type, U(0), _setup, _smch)
+
+/*
+ * Descriptor of a dedicated handler for a single SMC function ID. When
+ * SMC_FID_DISPATCH is enabled, SMCs with this function ID are passed to the
+ * handler straight away, instead of to the handler of the runtime service
+ * owning the function ID. The owning service must still be registered with
+ * DECLARE_RT_SVC() and initialised successfully for the handler to be used.
+ */
+typedef struct rt_svc_fid_desc {
+	uint32_t smc_fid;
+	uint8_t flags;
+	rt_svc_handle_t handle;
+} rt_svc_fid_desc_t;
+
+#define DECLARE_RT_SVC_FID_FLAGS(_name, _fid, _flags, _smch)		\
+	static const rt_svc_fid_desc_t __svc_fid_desc_ ## _name		\
+		__section("rt_svc_fids") __used = {			\
+			.smc_fid = (_fid),				\
+			.flags = (_flags),				\
+			.handle = (_smch)				\
+		}
+
+#define DECLARE_RT_SVC_FID(_name, _fid, _smch)				\
+	DECLARE_RT_SVC_FID_FLAGS(_name, _fid, U(0), _smch)
+
 /*
  * Compile time assertions related to the 'rt_svc_desc' structure to:
  * 1. ensure that the assembler and the compiler view of the size
@@ -89,6 +136,8 @@ typedef struct rt_svc_desc {
  *    routine at the same offset.
  * 3. ensure that the assembler and the compiler see the handler
  *    routine at the same offset.
+ * 4. ensure that the assembler and the compiler see the flags at the same
+ *    offset.
  */
 CASSERT((sizeof(rt_svc_desc_t) == SIZEOF_RT_SVC_DESC), \
 	assert_sizeof_rt_svc_desc_mismatch);
@@ -96,6 +145,8 @@ CASSERT(RT_SVC_DESC_INIT == __builtin_offsetof(rt_svc_desc_t, init), \
 	assert_rt_svc_desc_init_offset_mismatch);
 CASSERT(RT_SVC_DESC_HANDLE == __builtin_offsetof(rt_svc_desc_t, handle), \
 	assert_rt_svc_desc_handle_offset_mismatch);
+CASSERT(RT_SVC_DESC_FLAGS == __builtin_offsetof(rt_svc_desc_t, flags), \
+	assert_rt_svc_desc_flags_offset_mismatch);
 
 
 /*
@@ -130,9 +181,18 @@ uintptr_t handle_runtime_svc(uint32_t smc_fid, void *cookie, void *handle,
 						unsigned int flags);
 IMPORT_SYM(uintptr_t, __RT_SVC_DESCS_START__,		RT_SVC_DESCS_START);
 IMPORT_SYM(uintptr_t, __RT_SVC_DESCS_END__,		RT_SVC_DESCS_END);
+IMPORT_SYM(uintptr_t, __RT_SVC_FIDS_START__,		RT_SVC_FIDS_START);
+IMPORT_SYM(uintptr_t, __RT_SVC_FIDS_END__,		RT_SVC_FIDS_END);
 void init_crash_reporting(void);
 
 extern uint8_t rt_svc_descs_indices[MAX_RT_SVCS];
 
+#if SMC_FID_DISPATCH
+extern unsigned int rt_svc_fids_num;
+extern uint32_t rt_svc_fids[MAX_RT_SVC_FIDS];
+extern rt_svc_handle_t rt_svc_fid_handles[MAX_RT_SVC_FIDS];
+extern uint8_t rt_svc_fid_flags[MAX_RT_SVC_FIDS];
+#endif
+
 #endif /*__ASSEMBLY__*/
 #endif /* RUNTIME_SVC_H */
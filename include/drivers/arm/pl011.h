@@ -1,5 +1,5 @@
 /*
- * Copyright (c) 2013-2018, ARM Limited and Contributors. All rights reserved.
+ * Copyright (c) 2013-2019, ARM Limited and Contributors. All rights reserved.
  *
  * SPDX-License-Identifier: BSD-3-Clause
  */
@@ -47,6 +47,7 @@
 #define PL011_UARTFR_DSR          (1 << 1)	/* Data set ready */
 #define PL011_UARTFR_CTS          (1 << 0)	/* Clear to send */
 
+#define PL011_UARTFR_TXFE_BIT	7	/* Transmit FIFO empty bit in UARTFR register */
 #define PL011_UARTFR_TXFF_BIT	5	/* Transmit FIFO full bit in UARTFR register */
 #define PL011_UARTFR_RXFE_BIT	4	/* Receive FIFO empty bit in UARTFR register */
 #define PL011_UARTFR_BUSY_BIT	3	/* UART busy bit in UARTFR register */
@@ -81,6 +82,21 @@
 
 #endif /* !PL011_GENERIC_UART */
 
+/*
+ * Number of characters that can be written to the transmit FIFO once it has
+ * been found empty. The FIFO state of a generic UART is not known, so only one
+ * character is written per poll in that case.
+ */
+#if !defined(PL011_TX_FIFO_DEPTH)
+#if PL011_GENERIC_UART
+#define PL011_TX_FIFO_DEPTH	1
+#elif (PL011_LINE_CONTROL & PL011_UARTLCR_H_FEN) == 0
+#define PL011_TX_FIFO_DEPTH	1
+#else
+#define PL011_TX_FIFO_DEPTH	16
+#endif
+#endif
+
 #define CONSOLE_T_PL011_BASE	CONSOLE_T_DRVDATA
 
 #ifndef __ASSEMBLY__
@@ -1,5 +1,5 @@
 /*
- * Copyright (c) 2013-2018, ARM Limited and Contributors. All rights reserved.
+ * Copyright (c) 2013-2019, ARM Limited and Contributors. All rights reserved.
  *
  * SPDX-License-Identifier: BSD-3-Clause
  */
@@ -14,7 +14,8 @@
 #define CONSOLE_T_PUTC			(U(2) * REGSZ)
 #define CONSOLE_T_GETC			(U(3) * REGSZ)
 #define CONSOLE_T_FLUSH			(U(4) * REGSZ)
-#define CONSOLE_T_DRVDATA		(U(5) * REGSZ)
+#define CONSOLE_T_PUTS			(U(5) * REGSZ)
+#define CONSOLE_T_DRVDATA		(U(6) * REGSZ)
 
 #define CONSOLE_FLAG_BOOT		(U(1) << 0)
 #define CONSOLE_FLAG_RUNTIME		(U(1) << 1)
@@ -30,6 +31,7 @@
 
 #ifndef __ASSEMBLY__
 
+#include <stddef.h>
 #include <stdint.h>
 
 typedef struct console {
@@ -42,6 +44,12 @@ typedef struct console {
 	int (*const putc)(int character, struct console *console);
 	int (*const getc)(struct console *console);
 	int (*const flush)(struct console *console);
+	/*
+	 * Optional. Outputs 'len' characters and returns 'len' on success. It
+	 * allows drivers to fill a whole transmit FIFO per status register
+	 * poll. If NULL, putc() is called for each character instead.
+	 */
+	int (*const puts)(const char *str, size_t len, struct console *console);
 	/* Additional private driver data may follow here. */
 } console_t;
 
@@ -70,6 +78,8 @@ void console_set_scope(console_t *console, unsigned int scope);
 void console_switch_state(unsigned int new_state);
 /* Output a character on all consoles registered for the current state. */
 int console_putc(int c);
+/* Output 'len' characters on all consoles registered for the current state. */
+int console_puts(const char *str, size_t len);
 /* Read a character (blocking) from any console registered for current state. */
 int console_getc(void);
 /* Flush all consoles registered for the current state. */
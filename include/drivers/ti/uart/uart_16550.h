@@ -1,5 +1,5 @@
 /*
- * Copyright (c) 2015-2018, ARM Limited and Contributors. All rights reserved.
+ * Copyright (c) 2015-2019, ARM Limited and Contributors. All rights reserved.
  *
  * SPDX-License-Identifier: BSD-3-Clause
  */
@@ -63,7 +63,8 @@
 #define UARTLSR_TXFIFOFULL	(1 << 8)	/* Tx Fifo Full */
 #define UARTLSR_RXFIFOERR	(1 << 7)	/* Rx Fifo Error */
 #define UARTLSR_TEMT		(1 << 6)	/* Tx Shift Register Empty */
-#define UARTLSR_THRE		(1 << 5)	/* Tx Holding Register Empty */
+#define UARTLSR_THRE_BIT	(5)		/* Tx Holding Register Empty Bit */
+#define UARTLSR_THRE		(1 << UARTLSR_THRE_BIT)	/* Tx Holding Register Empty */
 #define UARTLSR_BRK		(1 << 4)	/* Break Condition Detected */
 #define UARTLSR_FERR		(1 << 3)	/* Framing Error */
 #define UARTLSR_PERR		(1 << 3)	/* Parity Error */
@@ -71,7 +72,18 @@
 #define UARTLSR_RDR_BIT		(0)		/* Rx Data Ready Bit */
 #define UARTLSR_RDR		(1 << UARTLSR_RDR_BIT)	/* Rx Data Ready */
 
-#define CONSOLE_T_16550_BASE	CONSOLE_T_DRVDATA
+/*
+ * Default number of characters that puts() writes to the transmit FIFO each
+ * time THRE is found set. Some 16550 compatible UARTs set THRE as soon as one
+ * slot of their FIFO is free, so only one character is written by default.
+ * The value of a console can be changed through its tx_fifo_depth field.
+ */
+#if !defined(UART_16550_TX_FIFO_DEPTH)
+#define UART_16550_TX_FIFO_DEPTH	1
+#endif
+
+#define CONSOLE_T_16550_BASE		CONSOLE_T_DRVDATA
+#define CONSOLE_T_16550_TX_FIFO_DEPTH	(CONSOLE_T_DRVDATA + REGSZ)
 
 #ifndef __ASSEMBLY__
 
@@ -80,13 +92,21 @@
 typedef struct {
 	console_t console;
 	uintptr_t base;
+	/*
+	 * Number of characters written per THRE poll by puts(). 0 is handled
+	 * like 1.
+	 */
+	uint32_t tx_fifo_depth;
 } console_16550_t;
 
 /*
  * Initialize a new 16550 console instance and register it with the console
  * framework. The |console| pointer must point to storage that will be valid
  * for the lifetime of the console, such as a global or static local variable.
- * Its contents will be reinitialized from scratch.
+ * Its contents will be reinitialized from scratch, with tx_fifo_depth set to
+ * UART_16550_TX_FIFO_DEPTH. A platform whose UART only sets THRE once its
+ * whole transmit FIFO is empty can raise tx_fifo_depth to the FIFO size after
+ * this call.
  */
 int console_16550_register(uintptr_t baseaddr, uint32_t clock, uint32_t baud,
 			   console_16550_t *console);
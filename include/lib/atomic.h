@@ -0,0 +1,15 @@
+/*
+ * Copyright (c) 2019, ARM Limited and Contributors. All rights reserved.
+ *
+ * SPDX-License-Identifier: BSD-3-Clause
+ */
+
+#ifndef ATOMIC_H
+#define ATOMIC_H
+
+#include <stdint.h>
+
+/* Only valid on cacheable Normal memory, and only implemented for AArch64 */
+void atomic_add_u32(volatile uint32_t *ptr, uint32_t val);
+
+#endif /* ATOMIC_H */
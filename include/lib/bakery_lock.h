@@ -66,6 +66,14 @@ typedef struct bakery_lock {
 	 * Bits[1 - 15] : number. This is the bakery number allocated.
 	 */
 	volatile uint16_t lock_data[BAKERY_LOCK_MAX_CPUS];
+#if USE_FAST_BAKERY_LOCK
+	/*
+	 * Shared variables of Lamport's fast mutual exclusion algorithm, used
+	 * instead of the Bakery algorithm. See bakery_lock_fast.c.
+	 */
+	volatile uint16_t fast_last;
+	volatile uint16_t fast_owner;
+#endif
 } bakery_lock_t;
 
 #else
@@ -86,6 +94,14 @@ typedef struct bakery_info {
 	 * Bits[1 - 15] : number. This is the bakery number allocated.
 	 */
 	volatile uint16_t lock_data;
+#if USE_FAST_BAKERY_LOCK
+	/*
+	 * Shared variables of Lamport's fast mutual exclusion algorithm. Only
+	 * those of the copy of CPU 0 are used. See bakery_lock_fast.c.
+	 */
+	volatile uint16_t fast_last;
+	volatile uint16_t fast_owner;
+#endif
 } bakery_info_t;
 
 typedef bakery_info_t bakery_lock_t;
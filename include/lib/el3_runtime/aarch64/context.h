@@ -7,6 +7,8 @@
 #ifndef CONTEXT_H
 #define CONTEXT_H
 
+#include <platform_def.h>	/* CACHE_WRITEBACK_GRANULE required */
+
 #include <lib/utils_def.h>
 
 /*******************************************************************************
@@ -59,16 +61,57 @@
 #define CTX_RUNTIME_SP		U(0x10)
 #define CTX_SPSR_EL3		U(0x18)
 #define CTX_ELR_EL3		U(0x20)
-#define CTX_UNUSED		U(0x28)
+/*
+ * With CTX_WORLD_AFFINITY, 1 + the index of the CPU whose registers hold the
+ * EL1 system registers of this context, 0 if none. Cleared by el3_exit.
+ */
+#define CTX_EL1_SYSREGS_CPU	U(0x28)
 #define CTX_EL3STATE_END	U(0x30)
 
+/*******************************************************************************
+ * Registers related to CVE-2018-3639
+ ******************************************************************************/
+#define CTX_CVE_2018_3639_OFFSET	(CTX_EL3STATE_OFFSET + CTX_EL3STATE_END)
+#define CTX_CVE_2018_3639_DISABLE	U(0)
+#define CTX_CVE_2018_3639_END		U(0x10) /* Align to the next 16 byte boundary */
+
+/*******************************************************************************
+ * Registers related to ARMv8.3-PAuth.
+ ******************************************************************************/
+#define CTX_PAUTH_REGS_OFFSET	(CTX_CVE_2018_3639_OFFSET + CTX_CVE_2018_3639_END)
+#if CTX_INCLUDE_PAUTH_REGS
+#define CTX_PACIAKEY_LO		U(0x0)
+#define CTX_PACIAKEY_HI		U(0x8)
+#define CTX_PACIBKEY_LO		U(0x10)
+#define CTX_PACIBKEY_HI		U(0x18)
+#define CTX_PACDAKEY_LO		U(0x20)
+#define CTX_PACDAKEY_HI		U(0x28)
+#define CTX_PACDBKEY_LO		U(0x30)
+#define CTX_PACDBKEY_HI		U(0x38)
+#define CTX_PACGAKEY_LO		U(0x40)
+#define CTX_PACGAKEY_HI		U(0x48)
+#define CTX_PACGAKEY_END	U(0x50)
+#define CTX_PAUTH_REGS_END	U(0x60) /* Align to the next 16 byte boundary */
+#else
+#define CTX_PAUTH_REGS_END	U(0)
+#endif /* CTX_INCLUDE_PAUTH_REGS */
+
+/*
+ * End of the state accessed on every exception entry and exit. The EL1 system
+ * registers and the floating point registers below are only accessed when
+ * switching between security states, so they start on the next cache line.
+ */
+#define CTX_HOT_END		(CTX_PAUTH_REGS_OFFSET + CTX_PAUTH_REGS_END)
+
 /*******************************************************************************
  * Constants that allow assembler code to access members of and the
  * 'el1_sys_regs' structure at their correct offsets. Note that some of the
  * registers are only 32-bits wide but are stored as 64-bit values for
  * convenience
  ******************************************************************************/
-#define CTX_SYSREGS_OFFSET	(CTX_EL3STATE_OFFSET + CTX_EL3STATE_END)
+#define CTX_SYSREGS_OFFSET	(((CTX_HOT_END + CACHE_WRITEBACK_GRANULE - U(1)) / \
+					CACHE_WRITEBACK_GRANULE) * \
+						CACHE_WRITEBACK_GRANULE)
 #define CTX_SPSR_EL1		U(0x0)
 #define CTX_ELR_EL1		U(0x8)
 #define CTX_SCTLR_EL1		U(0x10)
@@ -129,6 +172,24 @@
  */
 #define CTX_SYSREGS_END		CTX_TIMER_SYSREGS_END
 
+/*
+ * Optional groups of EL1 system registers. A group is only saved and restored
+ * by el1_sysregs_context_save() and el1_sysregs_context_restore() when its bit
+ * is set in their second argument. The fault and address translation
+ * registers are always switched, as their values would otherwise leak from one
+ * world to the other.
+ *
+ * EL0:     TPIDR_EL0 and TPIDRRO_EL0
+ * AARCH32: the AArch32 registers above, if CTX_INCLUDE_AARCH32_REGS is set
+ */
+#define CTX_EL1_GROUP_EL0_SHIFT		U(0)
+#define CTX_EL1_GROUP_AARCH32_SHIFT	U(1)
+
+#define CTX_EL1_GROUP_EL0		(U(1) << CTX_EL1_GROUP_EL0_SHIFT)
+#define CTX_EL1_GROUP_AARCH32		(U(1) << CTX_EL1_GROUP_AARCH32_SHIFT)
+#define CTX_EL1_GROUPS_ALL		(CTX_EL1_GROUP_EL0 | \
+					 CTX_EL1_GROUP_AARCH32)
+
 /*******************************************************************************
  * Constants that allow assembler code to access members of and the 'fp_regs'
  * structure at their correct offsets.
@@ -179,33 +240,14 @@
 #define CTX_FPREGS_END		U(0)
 #endif
 
-/*******************************************************************************
- * Registers related to CVE-2018-3639
- ******************************************************************************/
-#define CTX_CVE_2018_3639_OFFSET	(CTX_FPREGS_OFFSET + CTX_FPREGS_END)
-#define CTX_CVE_2018_3639_DISABLE	U(0)
-#define CTX_CVE_2018_3639_END		U(0x10) /* Align to the next 16 byte boundary */
-
-/*******************************************************************************
- * Registers related to ARMv8.3-PAuth.
- ******************************************************************************/
-#define CTX_PAUTH_REGS_OFFSET	(CTX_CVE_2018_3639_OFFSET + CTX_CVE_2018_3639_END)
-#if CTX_INCLUDE_PAUTH_REGS
-#define CTX_PACIAKEY_LO		U(0x0)
-#define CTX_PACIAKEY_HI		U(0x8)
-#define CTX_PACIBKEY_LO		U(0x10)
-#define CTX_PACIBKEY_HI		U(0x18)
-#define CTX_PACDAKEY_LO		U(0x20)
-#define CTX_PACDAKEY_HI		U(0x28)
-#define CTX_PACDBKEY_LO		U(0x30)
-#define CTX_PACDBKEY_HI		U(0x38)
-#define CTX_PACGAKEY_LO		U(0x40)
-#define CTX_PACGAKEY_HI		U(0x48)
-#define CTX_PACGAKEY_END	U(0x50)
-#define CTX_PAUTH_REGS_END	U(0x60) /* Align to the next 16 byte boundary */
-#else
-#define CTX_PAUTH_REGS_END	U(0)
-#endif /* CTX_INCLUDE_PAUTH_REGS */
+/*
+ * Size of the 'cpu_context' structure. Each instance is aligned to the cache
+ * writeback granule so that the contexts of different CPUs never share a line.
+ */
+#define CTX_END			(CTX_FPREGS_OFFSET + CTX_FPREGS_END)
+#define CTX_SIZE		(((CTX_END + CACHE_WRITEBACK_GRANULE - U(1)) / \
+					CACHE_WRITEBACK_GRANULE) * \
+						CACHE_WRITEBACK_GRANULE)
 
 #ifndef __ASSEMBLY__
 
@@ -294,15 +336,15 @@ DEFINE_REG_STRUCT(pauth, CTX_PAUTH_REGS_ALL);
 typedef struct cpu_context {
 	gp_regs_t gpregs_ctx;
 	el3_state_t el3state_ctx;
-	el1_sys_regs_t sysregs_ctx;
-#if CTX_INCLUDE_FPREGS
-	fp_regs_t fpregs_ctx;
-#endif
 	cve_2018_3639_t cve_2018_3639_ctx;
 #if CTX_INCLUDE_PAUTH_REGS
 	pauth_t pauth_ctx;
 #endif
-} cpu_context_t;
+	el1_sys_regs_t sysregs_ctx __aligned(CACHE_WRITEBACK_GRANULE);
+#if CTX_INCLUDE_FPREGS
+	fp_regs_t fpregs_ctx;
+#endif
+} __aligned(CACHE_WRITEBACK_GRANULE) cpu_context_t;
 
 /* Macros to access members of the 'cpu_context_t' structure */
 #define get_el3state_ctx(h)	(&((cpu_context_t *) h)->el3state_ctx)
@@ -337,6 +379,8 @@ CASSERT(CTX_CVE_2018_3639_OFFSET == __builtin_offsetof(cpu_context_t, cve_2018_3
 CASSERT(CTX_PAUTH_REGS_OFFSET == __builtin_offsetof(cpu_context_t, pauth_ctx), \
 	assert_core_context_pauth_offset_mismatch);
 #endif
+CASSERT(CTX_SIZE == sizeof(cpu_context_t), \
+	assert_core_context_size_mismatch);
 
 /*
  * Helper macro to set the general purpose registers that correspond to
@@ -377,8 +421,8 @@ CASSERT(CTX_PAUTH_REGS_OFFSET == __builtin_offsetof(cpu_context_t, pauth_ctx), \
 /*******************************************************************************
  * Function prototypes
  ******************************************************************************/
-void el1_sysregs_context_save(el1_sys_regs_t *regs);
-void el1_sysregs_context_restore(el1_sys_regs_t *regs);
+void el1_sysregs_context_save(el1_sys_regs_t *regs, unsigned int groups);
+void el1_sysregs_context_restore(el1_sys_regs_t *regs, unsigned int groups);
 #if CTX_INCLUDE_FPREGS
 void fpregs_context_save(fp_regs_t *regs);
 void fpregs_context_restore(fp_regs_t *regs);
@@ -38,6 +38,18 @@ void cm_prepare_el3_exit(uint32_t security_state);
 #ifndef AARCH32
 void cm_el1_sysregs_context_save(uint32_t security_state);
 void cm_el1_sysregs_context_restore(uint32_t security_state);
+void cm_set_el1_sysregs_groups(unsigned int groups);
+#if CTX_WORLD_AFFINITY
+void cm_el1_sysregs_context_invalidate(void);
+#endif
+#if CTX_INCLUDE_FPREGS
+void cm_fpregs_context_save(uint32_t security_state);
+void cm_fpregs_context_restore(uint32_t security_state);
+#endif
+#if CTX_LAZY_FPREGS
+void cm_fpregs_trap_handler(void);
+void cm_fpregs_context_flush(void);
+#endif
 void cm_set_elr_el3(uint32_t security_state, uintptr_t entrypoint);
 void cm_set_elr_spsr_el3(uint32_t security_state,
 			uintptr_t entrypoint, uint32_t spsr);
@@ -16,12 +16,16 @@
 #if CRASH_REPORTING
 #error "Crash reporting is not supported in AArch32"
 #endif
+#if CRASH_DUMP
+#error "Crash dump is not supported in AArch32"
+#endif
 #define CPU_DATA_CPU_OPS_PTR		0x0
 #define CPU_DATA_CRASH_BUF_OFFSET	0x4
 
 #else /* AARCH32 */
 
 /* Offsets for the cpu_data structure */
+#define CPU_DATA_CONTEXT_OFFSET		0x0
 #define CPU_DATA_CRASH_BUF_OFFSET	0x18
 /* need enough space in crash buffer to save 8 registers */
 #define CPU_DATA_CRASH_BUF_SIZE		64
@@ -29,7 +33,7 @@
 
 #endif /* AARCH32 */
 
-#if CRASH_REPORTING
+#if CRASH_REPORTING || CRASH_DUMP
 #define CPU_DATA_CRASH_BUF_END		(CPU_DATA_CRASH_BUF_OFFSET + \
 						CPU_DATA_CRASH_BUF_SIZE)
 #else
@@ -88,7 +92,7 @@ typedef struct cpu_data {
 	void *cpu_context[2];
 #endif
 	uintptr_t cpu_ops_ptr;
-#if CRASH_REPORTING
+#if CRASH_REPORTING || CRASH_DUMP
 	u_register_t crash_buf[CPU_DATA_CRASH_BUF_SIZE >> 3];
 #endif
 #if ENABLE_RUNTIME_INSTRUMENTATION
@@ -105,7 +109,13 @@ typedef struct cpu_data {
 
 extern cpu_data_t percpu_data[PLATFORM_CORE_COUNT];
 
-#if CRASH_REPORTING
+#ifndef AARCH32
+CASSERT(CPU_DATA_CONTEXT_OFFSET == __builtin_offsetof
+	(cpu_data_t, cpu_context),
+	assert_cpu_data_context_offset_mismatch);
+#endif
+
+#if CRASH_REPORTING || CRASH_DUMP
 /* verify assembler offsets match data structures */
 CASSERT(CPU_DATA_CRASH_BUF_OFFSET == __builtin_offsetof
 	(cpu_data_t, crash_buf),
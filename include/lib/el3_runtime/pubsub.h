@@ -58,11 +58,20 @@
 
 /*
  * In compiler context, REGISTER_PUBSUB_EVENT declares the per-event symbols
- * exported by the linker required for the other pubsub macros to work.
+ * exported by the linker required for the other pubsub macros to work. With
+ * PUBSUB_DIRECT_CALLS, it also declares the publish function of the event,
+ * generated at link time by gen_pubsub_calls.sh.
  */
+#if PUBSUB_DIRECT_CALLS
+#define REGISTER_PUBSUB_EVENT(event) \
+	extern pubsub_cb_t __pubsub_start_sym(event)[]; \
+	extern pubsub_cb_t __pubsub_end_sym(event)[]; \
+	void __pubsub_publish_##event(const void *arg)
+#else
 #define REGISTER_PUBSUB_EVENT(event) \
 	extern pubsub_cb_t __pubsub_start_sym(event)[]; \
 	extern pubsub_cb_t __pubsub_end_sym(event)[]
+#endif
 
 /*
  * Have the function func called back when the specified event happens. This
@@ -72,9 +81,24 @@
  * The extern declaration is there to satisfy MISRA C-2012 rule 8.4.
  */
 #define SUBSCRIBE_TO_EVENT(event, func) \
+	__pubsub_direct_call(event, func) \
 	extern pubsub_cb_t __cb_func_##func##event __pubsub_section(event); \
 	pubsub_cb_t __cb_func_##func##event __pubsub_section(event) = (func)
 
+/*
+ * With PUBSUB_DIRECT_CALLS, give the handler a global name from which
+ * gen_pubsub_calls.sh can tell the event, so that the publish function of the
+ * event can call it directly.
+ */
+#if PUBSUB_DIRECT_CALLS
+#define __pubsub_direct_call(event, func) \
+	extern __typeof__(func) __pubsub_sub_##func##event \
+		__asm__("__pubsub_sub." #event "." #func) \
+		__attribute__((alias(#func)));
+#else
+#define __pubsub_direct_call(event, func)
+#endif
+
 /*
  * Iterate over subscribed handlers for a defined event. 'event' is the name of
  * the event, and 'subscriber' a local variable of type 'pubsub_cb_t *'.
@@ -88,6 +112,10 @@
  * Publish a defined event supplying an argument. All subscribed handlers are
  * invoked, but the return value of handlers are ignored for now.
  */
+#if PUBSUB_DIRECT_CALLS
+#define PUBLISH_EVENT_ARG(event, arg) \
+	__pubsub_publish_##event(arg)
+#else
 #define PUBLISH_EVENT_ARG(event, arg) \
 	do { \
 		pubsub_cb_t *subscriber; \
@@ -95,6 +123,7 @@
 			(*subscriber)(arg); \
 		} \
 	} while (0)
+#endif
 
 /* Publish a defined event with NULL argument */
 #define PUBLISH_EVENT(event)	PUBLISH_EVENT_ARG(event, NULL)
@@ -59,6 +59,7 @@
 #define PSCI_NODE_HW_STATE_AARCH64	U(0xc400000d)
 #define PSCI_SYSTEM_SUSPEND_AARCH32	U(0x8400000E)
 #define PSCI_SYSTEM_SUSPEND_AARCH64	U(0xc400000E)
+#define PSCI_SET_SUSPEND_MODE		U(0x8400000F)
 #define PSCI_STAT_RESIDENCY_AARCH32	U(0x84000010)
 #define PSCI_STAT_RESIDENCY_AARCH64	U(0xc4000010)
 #define PSCI_STAT_COUNT_AARCH32		U(0x84000011)
@@ -72,8 +73,12 @@
 /*
  * Number of PSCI calls (above) implemented
  */
-#if ENABLE_PSCI_STAT
+#if ENABLE_PSCI_STAT && PSCI_OS_INIT_MODE
+#define PSCI_NUM_CALLS			U(23)
+#elif ENABLE_PSCI_STAT
 #define PSCI_NUM_CALLS			U(22)
+#elif PSCI_OS_INIT_MODE
+#define PSCI_NUM_CALLS			U(19)
 #else
 #define PSCI_NUM_CALLS			U(18)
 #endif
@@ -134,7 +139,11 @@
 
 /* Features flags for CPU SUSPEND OS Initiated mode support. Bits [0:0] */
 #define FF_MODE_SUPPORT_SHIFT		U(0)
+#if PSCI_OS_INIT_MODE
 #define FF_SUPPORTS_OS_INIT_MODE	U(1)
+#else
+#define FF_SUPPORTS_OS_INIT_MODE	U(0)
+#endif
 
 /*******************************************************************************
  * PSCI version
@@ -206,6 +215,16 @@ typedef enum {
 	AFF_STATE_ON_PENDING = U(2)
 } aff_info_state_t;
 
+/*
+ * These are the modes set by the PSCI_SET_SUSPEND_MODE API. The definitions of
+ * these modes can be found in Section 5.20.2 of the PSCI specification (ARM DEN
+ * 0022D).
+ */
+typedef enum {
+	PLAT_COORD = U(0),
+	OS_INIT = U(1)
+} suspend_mode_t;
+
 /*
  * These are the power states reported by PSCI_NODE_HW_STATE API for the
  * specified CPU. The definitions of these states can be found in Section 5.15.3
@@ -332,6 +351,11 @@ unsigned int psci_version(void);
 int psci_cpu_on(u_register_t target_cpu,
 		uintptr_t entrypoint,
 		u_register_t context_id);
+int psci_cpu_on_many(u_register_t target_cluster,
+		     u_register_t target_mask,
+		     uintptr_t entrypoint,
+		     u_register_t context_id,
+		     u_register_t *on_mask);
 int psci_cpu_suspend(unsigned int power_state,
 		     uintptr_t entrypoint,
 		     u_register_t context_id);
@@ -345,6 +369,12 @@ u_register_t psci_migrate_info_up_cpu(void);
 int psci_node_hw_state(u_register_t target_cpu,
 		       unsigned int power_level);
 int psci_features(unsigned int psci_fid);
+#if ENABLE_PSCI_STAT
+int psci_stat_last_idle(u_register_t *states, u_register_t *residency);
+#endif
+#if PSCI_OS_INIT_MODE
+int psci_set_suspend_mode(unsigned int mode);
+#endif
 void __dead2 psci_power_down_wfi(void);
 void psci_arch_setup(void);
 
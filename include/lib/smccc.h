@@ -83,6 +83,9 @@
 #define SMC_UNK				-1
 #define SMC_PREEMPTED			-2	/* Not defined by the SMCCC */
 
+/* Number of registers used for arguments and results by SMCCC v1.2 (x0-x17) */
+#define SMCCC_GP_REGS_NUM		U(18)
+
 /* Various flags passed to SMC handlers */
 #define SMC_FROM_SECURE		(U(0) << 0)
 #define SMC_FROM_NON_SECURE	(U(1) << 0)
@@ -19,8 +19,17 @@
 /* Function ID for requesting state switch of lower EL */
 #define ARM_SIP_SVC_EXE_STATE_SWITCH	U(0x82000020)
 
+/* Function ID for powering on several CPUs of a cluster */
+#define ARM_SIP_SVC_CPU_ON_MANY		U(0xc2000021)
+
+/* Function ID for querying the last idle state entered by the calling CPU */
+#define ARM_SIP_SVC_PSCI_LAST_IDLE	U(0xc2000022)
+
+/* Function ID for making several read-only Standard Service calls */
+#define ARM_SIP_SVC_BATCH		U(0xc2000023)
+
 /* ARM SiP Service Calls version numbers */
 #define ARM_SIP_SVC_VERSION_MAJOR		U(0x0)
-#define ARM_SIP_SVC_VERSION_MINOR		U(0x2)
+#define ARM_SIP_SVC_VERSION_MINOR		U(0x4)
 
 #endif /* ARM_SIP_SVC_H */
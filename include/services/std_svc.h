@@ -7,6 +7,8 @@
 #ifndef STD_SVC_H
 #define STD_SVC_H
 
+#include <stdint.h>
+
 /* SMC function IDs for Standard Service queries */
 
 #define ARM_STD_SVC_CALL_COUNT		0x8400ff00
@@ -18,6 +20,26 @@
 #define STD_SVC_VERSION_MAJOR		0x0
 #define STD_SVC_VERSION_MINOR		0x1
 
+/*
+ * Record of the batched query call. The Standard Service range has no free
+ * function ID for it, so the call is exposed by the platform SiP service,
+ * which passes the address of an array of these records in the platform batch
+ * buffer and their number to std_svc_batch(). For each record, the call
+ * identified by 'fid' is made with the arguments 'args' and its return values
+ * are written to 'ret'. Calls that are not permitted in a batch return SMC_UNK
+ * in ret[0].
+ */
+typedef struct std_svc_batch_rec {
+	uint64_t fid;
+	uint64_t args[3];
+	uint64_t ret[2];
+} std_svc_batch_rec_t;
+
+#if STD_SVC_BATCH
+uintptr_t std_svc_batch(u_register_t addr, u_register_t count, void *handle,
+			u_register_t flags);
+#endif
+
 /*
  * Get the ARM Standard Service argument from EL3 Runtime.
  * This function must be implemented by EL3 Runtime and the
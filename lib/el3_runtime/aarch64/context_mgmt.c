@@ -25,6 +25,51 @@
 #include <plat/common/platform.h>
 #include <smccc_helpers.h>
 
+/*
+ * Optional groups of EL1 system registers switched between the two worlds by
+ * cm_el1_sysregs_context_save() and cm_el1_sysregs_context_restore().
+ */
+static unsigned int el1_sysregs_groups = CTX_EL1_GROUPS_ALL;
+
+static void el1_sysregs_restore(uint32_t security_state, unsigned int groups);
+
+#if CTX_WORLD_AFFINITY && IMAGE_BL31
+/*
+ * The context whose EL1 system registers are held by the registers of each
+ * CPU, if any. It is only valid if the CTX_EL1_SYSREGS_CPU field of the context
+ * also designates the CPU, as the field is cleared when the context is entered
+ * and updated when it is switched on another CPU.
+ */
+static const cpu_context_t *el1_sysregs_live_ctx[PLATFORM_CORE_COUNT];
+
+static bool el1_sysregs_live(const cpu_context_t *ctx, unsigned int core_pos)
+{
+	return (el1_sysregs_live_ctx[core_pos] == ctx) &&
+	       (read_ctx_reg(get_el3state_ctx(ctx), CTX_EL1_SYSREGS_CPU) ==
+		(core_pos + 1U));
+}
+
+static void el1_sysregs_set_live(cpu_context_t *ctx, unsigned int core_pos)
+{
+	el1_sysregs_live_ctx[core_pos] = ctx;
+	write_ctx_reg(get_el3state_ctx(ctx), CTX_EL1_SYSREGS_CPU,
+		      core_pos + 1U);
+}
+#endif
+
+#if CTX_LAZY_FPREGS && IMAGE_BL31
+/*
+ * World whose values the floating point registers of each CPU hold. They hold
+ * the values of no world after a reset, until the first trapped access.
+ */
+#define FPREGS_OWNER_NONE		U(0)
+#define FPREGS_OWNER(security_state)	((security_state) + 1U)
+#define FPREGS_OWNER_STATE(owner)	((owner) - 1U)
+
+static unsigned int fpregs_owner[PLATFORM_CORE_COUNT];
+
+static void fpregs_set_trap(uint32_t security_state);
+#endif
 
 /*******************************************************************************
  * Context management library initialisation routine. This library is used by
@@ -488,23 +533,64 @@ void cm_prepare_el3_exit(uint32_t security_state)
 		enable_extensions_nonsecure(el2_unused);
 	}
 
-	cm_el1_sysregs_context_restore(security_state);
+	/*
+	 * This is the first entry into this context, so restore all of its
+	 * EL1 system registers.
+	 */
+#if CTX_WORLD_AFFINITY && IMAGE_BL31
+	cm_el1_sysregs_context_invalidate();
+#endif
+	el1_sysregs_restore(security_state, CTX_EL1_GROUPS_ALL);
+#if CTX_LAZY_FPREGS && IMAGE_BL31
+	fpregs_set_trap(security_state);
+#endif
 	cm_set_next_eret_context(security_state);
 }
 
+/*******************************************************************************
+ * This function declares the optional groups of EL1 system registers
+ * (CTX_EL1_GROUP_*) used by the Secure world. The other groups are not saved
+ * nor restored when switching worlds, so the Secure world sees the values of
+ * the Normal world and must not modify them. It must be called by the Secure
+ * payload dispatcher before the first world switch.
+ ******************************************************************************/
+void cm_set_el1_sysregs_groups(unsigned int groups)
+{
+	assert((groups & ~CTX_EL1_GROUPS_ALL) == 0U);
+
+	el1_sysregs_groups = groups;
+}
+
 /*******************************************************************************
  * The next four functions are used by runtime services to save and restore
  * EL1 context on the 'cpu_context' structure for the specified security
  * state.
+ *
+ * With CTX_WORLD_AFFINITY, the copy is skipped when the registers of this CPU
+ * already hold the EL1 context of the 'cpu_context' structure, i.e. when it
+ * has been saved or restored on this CPU and not entered since. This is the
+ * case when EL3 returns to the world it has just saved, or saves a world it
+ * has not entered since the last switch.
  ******************************************************************************/
 void cm_el1_sysregs_context_save(uint32_t security_state)
 {
 	cpu_context_t *ctx;
+#if CTX_WORLD_AFFINITY && IMAGE_BL31
+	unsigned int core_pos = plat_my_core_pos();
+#endif
 
 	ctx = cm_get_context(security_state);
 	assert(ctx != NULL);
 
-	el1_sysregs_context_save(get_sysregs_ctx(ctx));
+#if CTX_WORLD_AFFINITY && IMAGE_BL31
+	if (!el1_sysregs_live(ctx, core_pos)) {
+		el1_sysregs_context_save(get_sysregs_ctx(ctx),
+					 el1_sysregs_groups);
+		el1_sysregs_set_live(ctx, core_pos);
+	}
+#else
+	el1_sysregs_context_save(get_sysregs_ctx(ctx), el1_sysregs_groups);
+#endif
 
 #if IMAGE_BL31
 	if (security_state == SECURE)
@@ -514,14 +600,21 @@ void cm_el1_sysregs_context_save(uint32_t security_state)
 #endif
 }
 
-void cm_el1_sysregs_context_restore(uint32_t security_state)
+static void el1_sysregs_restore(uint32_t security_state, unsigned int groups)
 {
 	cpu_context_t *ctx;
 
 	ctx = cm_get_context(security_state);
 	assert(ctx != NULL);
 
-	el1_sysregs_context_restore(get_sysregs_ctx(ctx));
+#if CTX_WORLD_AFFINITY && IMAGE_BL31
+	if (!el1_sysregs_live(ctx, plat_my_core_pos())) {
+		el1_sysregs_context_restore(get_sysregs_ctx(ctx), groups);
+		el1_sysregs_set_live(ctx, plat_my_core_pos());
+	}
+#else
+	el1_sysregs_context_restore(get_sysregs_ctx(ctx), groups);
+#endif
 
 #if IMAGE_BL31
 	if (security_state == SECURE)
@@ -531,6 +624,148 @@ void cm_el1_sysregs_context_restore(uint32_t security_state)
 #endif
 }
 
+void cm_el1_sysregs_context_restore(uint32_t security_state)
+{
+	el1_sysregs_restore(security_state, el1_sysregs_groups);
+}
+
+#if CTX_WORLD_AFFINITY && IMAGE_BL31
+/*******************************************************************************
+ * This function forgets which EL1 context is held by the registers of this
+ * CPU. It must be called before the CPU is powered down, and after a runtime
+ * service writes the EL1 system registers of a context it has just saved or
+ * restored.
+ ******************************************************************************/
+void cm_el1_sysregs_context_invalidate(void)
+{
+	el1_sysregs_live_ctx[plat_my_core_pos()] = NULL;
+}
+#endif
+
+#if CTX_INCLUDE_FPREGS
+#if CTX_LAZY_FPREGS && IMAGE_BL31
+/*
+ * Trap the accesses to the floating point registers from the lower ELs unless
+ * they hold the values of the given security state. The write to CPTR_EL3 is
+ * synchronised by the exception return to the lower EL.
+ */
+static void fpregs_set_trap(uint32_t security_state)
+{
+	u_register_t cptr_el3 = read_cptr_el3();
+
+	if (fpregs_owner[plat_my_core_pos()] == FPREGS_OWNER(security_state))
+		cptr_el3 &= ~TFP_BIT;
+	else
+		cptr_el3 |= TFP_BIT;
+
+	write_cptr_el3(cptr_el3);
+}
+
+/*******************************************************************************
+ * Handler of the accesses to the floating point registers trapped by
+ * fpregs_set_trap(). It switches the registers to the values of the world that
+ * caused the trap, and disables the trap so that the access is retried
+ * successfully.
+ ******************************************************************************/
+void cm_fpregs_trap_handler(void)
+{
+	unsigned int core_pos = plat_my_core_pos();
+	unsigned int owner = fpregs_owner[core_pos];
+	uint32_t security_state;
+	cpu_context_t *ctx;
+
+	security_state = ((read_scr_el3() & SCR_NS_BIT) != 0U) ?
+			 NON_SECURE : SECURE;
+
+	/* The trap also applies to EL3, so disable it first */
+	write_cptr_el3(read_cptr_el3() & ~TFP_BIT);
+	isb();
+
+	if (owner == FPREGS_OWNER(security_state))
+		return;
+
+	/* The registers hold UNKNOWN values when they have no owner */
+	if (owner != FPREGS_OWNER_NONE) {
+		ctx = cm_get_context(FPREGS_OWNER_STATE(owner));
+		assert(ctx != NULL);
+		fpregs_context_save(get_fpregs_ctx(ctx));
+	}
+
+	ctx = cm_get_context(security_state);
+	assert(ctx != NULL);
+	fpregs_context_restore(get_fpregs_ctx(ctx));
+
+	fpregs_owner[core_pos] = FPREGS_OWNER(security_state);
+}
+
+/*******************************************************************************
+ * This function saves the floating point registers of this CPU to the context
+ * of the world whose values they hold, if any, and then forgets it. The next
+ * access from any world is trapped and restores the registers from its
+ * context. It must be called before the CPU is powered down, as the registers
+ * are lost, or might be lost if the power down is abandoned after this call.
+ ******************************************************************************/
+void cm_fpregs_context_flush(void)
+{
+	unsigned int core_pos = plat_my_core_pos();
+	unsigned int owner = fpregs_owner[core_pos];
+	u_register_t cptr_el3 = read_cptr_el3();
+	cpu_context_t *ctx;
+
+	if (owner != FPREGS_OWNER_NONE) {
+		write_cptr_el3(cptr_el3 & ~TFP_BIT);
+		isb();
+
+		ctx = cm_get_context(FPREGS_OWNER_STATE(owner));
+		assert(ctx != NULL);
+		fpregs_context_save(get_fpregs_ctx(ctx));
+
+		fpregs_owner[core_pos] = FPREGS_OWNER_NONE;
+	}
+
+	write_cptr_el3(cptr_el3 | TFP_BIT);
+	isb();
+}
+#endif /* CTX_LAZY_FPREGS && IMAGE_BL31 */
+
+/*******************************************************************************
+ * The next two functions are used by runtime services to save and restore the
+ * floating point registers on the 'cpu_context' structure for the specified
+ * security state, when switching worlds.
+ *
+ * With CTX_LAZY_FPREGS, the registers are not switched straight away. Instead,
+ * the accesses of the world being entered to the registers are trapped to EL3
+ * until they hold its values, and the registers are switched on the first
+ * trap. A world that doesn't use the floating point registers between two
+ * world switches doesn't pay for them.
+ ******************************************************************************/
+void cm_fpregs_context_save(uint32_t security_state)
+{
+#if !(CTX_LAZY_FPREGS && IMAGE_BL31)
+	cpu_context_t *ctx;
+
+	ctx = cm_get_context(security_state);
+	assert(ctx != NULL);
+
+	fpregs_context_save(get_fpregs_ctx(ctx));
+#endif
+}
+
+void cm_fpregs_context_restore(uint32_t security_state)
+{
+#if CTX_LAZY_FPREGS && IMAGE_BL31
+	fpregs_set_trap(security_state);
+#else
+	cpu_context_t *ctx;
+
+	ctx = cm_get_context(security_state);
+	assert(ctx != NULL);
+
+	fpregs_context_restore(get_fpregs_ctx(ctx));
+#endif
+}
+#endif /* CTX_INCLUDE_FPREGS */
+
 /*******************************************************************************
  * This function populates ELR_EL3 member of 'cpu_context' pertaining to the
  * given security state with the given entrypoint
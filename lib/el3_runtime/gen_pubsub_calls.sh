@@ -0,0 +1,99 @@
+#!/bin/sh
+# Copyright (c) 2019, ARM Limited and Contributors. All rights reserved.
+#
+# SPDX-License-Identifier: BSD-3-Clause
+
+# Generate the publish functions used by PUBSUB_DIRECT_CALLS.
+#
+# The input is the output of 'nm -p' run on the objects of a BL image, in link
+# order, read from the files given as arguments or from the standard input.
+# With PUBSUB_DIRECT_CALLS, PUBLISH_EVENT*() calls __pubsub_publish_<event>()
+# and SUBSCRIBE_TO_EVENT() defines a global alias of the handler called
+# __pubsub_sub.<event>.<handler>. The output is a C file defining a publish
+# function for each event published by the image, which calls the handlers of
+# the event directly, in link order. The publish function of an event without
+# handlers does nothing.
+
+set -e
+
+output=pubsub_calls.c
+
+while [ $# -gt 0 ]
+do
+	case $1 in
+	-o)
+		[ $# -ge 2 ] || {
+			echo usage: gen_pubsub_calls.sh [-o output] [file ...] >&2
+			exit 1
+		}
+		output=$2
+		shift 2
+		;;
+	--)
+		shift
+		break
+		;;
+	-*)
+		echo usage: gen_pubsub_calls.sh [-o output] [file ...] >&2
+		exit 1
+		;;
+	*)
+		break
+		;;
+	esac
+done
+
+tmp=`mktemp`
+trap "rm -f $tmp" EXIT INT QUIT
+
+cat "$@" |
+awk '
+BEGIN {nevents = 0; nsubs = 0}
+
+NF == 2 && $1 == "U" && $2 ~ /^__pubsub_publish_/ {
+	event = substr($2, length("__pubsub_publish_") + 1)
+	if (!(event in published)) {
+		published[event] = 1
+		events[nevents++] = event
+	}
+	next
+}
+
+NF == 3 && $2 == "T" && $3 ~ /^__pubsub_sub\./ {
+	split($3, parts, ".")
+	sub_event[nsubs] = parts[2]
+	sub_sym[nsubs] = $3
+	nsubs++
+}
+
+END {
+	print "/* Generated by gen_pubsub_calls.sh, do not edit */"
+
+	for (i = 0; i < nsubs; i++) {
+		if (!(sub_event[i] in published))
+			continue
+		print ""
+		printf "void *__pubsub_sub_%d(const void *arg) __asm__(\"%s\");\n", \
+			i, sub_sym[i]
+	}
+
+	for (e = 0; e < nevents; e++) {
+		event = events[e]
+		print ""
+		printf "void __pubsub_publish_%s(const void *arg);\n", event
+		printf "void __pubsub_publish_%s(const void *arg)\n", event
+		print "{"
+		n = 0
+		for (i = 0; i < nsubs; i++) {
+			if (sub_event[i] != event)
+				continue
+			printf "\t(void)__pubsub_sub_%d(arg);\n", i
+			n++
+		}
+		if (n == 0)
+			print "\t(void)arg;"
+		print "}"
+	}
+}' > $tmp
+
+mv $tmp $output
@@ -34,7 +34,12 @@ static void *disable_sve_hook(const void *arg)
 	 * in the Secure world as well as SVE functionality.
 	 */
 	cptr = read_cptr_el3();
+#if CTX_LAZY_FPREGS
+	/* CPTR_EL3.TFP tracks the owner of the FP registers instead */
+	cptr &= ~(CPTR_EZ_BIT);
+#else
 	cptr = (cptr | TFP_BIT) & ~(CPTR_EZ_BIT);
+#endif
 	write_cptr_el3(cptr);
 
 	/*
@@ -55,7 +60,12 @@ static void *enable_sve_hook(const void *arg)
 	 * Enable SVE, SIMD and FP access for the Non-secure world.
 	 */
 	cptr = read_cptr_el3();
+#if CTX_LAZY_FPREGS
+	/* CPTR_EL3.TFP tracks the owner of the FP registers instead */
+	cptr |= CPTR_EZ_BIT;
+#else
 	cptr = (cptr | CPTR_EZ_BIT) & ~(TFP_BIT);
+#endif
 	write_cptr_el3(cptr);
 
 	/*
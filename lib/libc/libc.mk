@@ -14,6 +14,7 @@ LIBC_SRCS	:=	$(addprefix lib/libc/,		\
 			memmove.c			\
 			memset.c			\
 			printf.c			\
+			printf_format.c			\
 			putchar.c			\
 			puts.c				\
 			snprintf.c			\
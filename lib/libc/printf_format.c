@@ -0,0 +1,311 @@
+/*
+ * Copyright (c) 2014-2019, ARM Limited and Contributors. All rights reserved.
+ *
+ * SPDX-License-Identifier: BSD-3-Clause
+ */
+
+#include <assert.h>
+#include <stdarg.h>
+#include <stdbool.h>
+#include <stdint.h>
+
+#include "printf_private.h"
+
+#define get_num_va_args(_args, _lcount)				\
+	(((_lcount) > 1)  ? va_arg(_args, long long int) :	\
+	(((_lcount) == 1) ? va_arg(_args, long int) :		\
+			    va_arg(_args, int)))
+
+#define get_unum_va_args(_args, _lcount)				\
+	(((_lcount) > 1)  ? va_arg(_args, unsigned long long int) :	\
+	(((_lcount) == 1) ? va_arg(_args, unsigned long int) :		\
+			    va_arg(_args, unsigned int)))
+
+/* Enough space to store a 64 bit decimal integer */
+#define NUM_BUF_SIZE	20
+
+/* Conversion options parsed from a format specifier */
+typedef struct {
+	char padc;	/* Padding character, ' ' or '0' */
+	int width;	/* Minimum field width */
+	int prec;	/* Precision, or -1 if not specified */
+} fmt_spec_t;
+
+static const char hex_digits[16] = "0123456789abcdef";
+
+static inline void sink_putc(printf_sink_t *sink, char c)
+{
+	if ((sink->len == sink->size) && (sink->flush != NULL)) {
+		sink->flush(sink);
+		assert(sink->len == 0U);
+	}
+
+	if (sink->len < sink->size) {
+		sink->buf[sink->len] = c;
+		sink->len++;
+	}
+
+	sink->count++;
+}
+
+static void sink_fill(printf_sink_t *sink, char c, int n)
+{
+	for ( ; n > 0; n--) {
+		sink_putc(sink, c);
+	}
+}
+
+static void sink_write(printf_sink_t *sink, const char *str, int n)
+{
+	for ( ; n > 0; n--) {
+		sink_putc(sink, *str);
+		str++;
+	}
+}
+
+/*
+ * Unsigned 64-bit division by 10 using only shifts and adds, see "Hacker's
+ * Delight", 2nd edition, section 10-17. This keeps the compiler from
+ * calling the generic 64-bit division helpers on AArch32.
+ */
+static unsigned long long int udiv10(unsigned long long int n,
+				     unsigned int *rem)
+{
+	unsigned long long int q, r;
+
+	q = (n >> 1) + (n >> 2);
+	q += q >> 4;
+	q += q >> 8;
+	q += q >> 16;
+	q += q >> 32;
+	q >>= 3;
+	r = n - (((q << 2) + q) << 1);
+	if (r > 9ULL) {
+		q++;
+		r -= 10ULL;
+	}
+
+	*rem = (unsigned int)r;
+	return q;
+}
+
+/*
+ * Write the digits of 'unum' backwards, ending just before 'end'. Returns
+ * the number of digits written.
+ */
+static int format_hex(char *end, unsigned long long int unum)
+{
+	char *p = end;
+	unsigned int u32;
+
+	while (unum > UINT32_MAX) {
+		p--;
+		*p = hex_digits[unum & 0xfULL];
+		unum >>= 4;
+	}
+
+	u32 = (unsigned int)unum;
+	do {
+		p--;
+		*p = hex_digits[u32 & 0xfU];
+		u32 >>= 4;
+	} while (u32 != 0U);
+
+	return (int)(end - p);
+}
+
+static int format_dec(char *end, unsigned long long int unum)
+{
+	char *p = end;
+	unsigned int rem, u32;
+
+	while (unum > UINT32_MAX) {
+		unum = udiv10(unum, &rem);
+		p--;
+		*p = (char)('0' + rem);
+	}
+
+	/* The compiler turns 32-bit division by a constant into a multiply */
+	u32 = (unsigned int)unum;
+	do {
+		p--;
+		*p = (char)('0' + (u32 % 10U));
+		u32 /= 10U;
+	} while (u32 != 0U);
+
+	return (int)(end - p);
+}
+
+static void num_print(printf_sink_t *sink, unsigned long long int unum,
+		      unsigned int radix, const char *prefix,
+		      const fmt_spec_t *spec)
+{
+	char num_buf[NUM_BUF_SIZE];
+	char *end = &num_buf[NUM_BUF_SIZE];
+	int digits, prefix_len = 0, zeros = 0, spaces;
+
+	if (radix == 16U) {
+		digits = format_hex(end, unum);
+	} else {
+		digits = format_dec(end, unum);
+	}
+
+	while (prefix[prefix_len] != '\0') {
+		prefix_len++;
+	}
+
+	if (spec->prec >= 0) {
+		/* A precision gives the minimum number of digits */
+		if (spec->prec > digits) {
+			zeros = spec->prec - digits;
+		}
+	} else if (spec->padc == '0') {
+		if (spec->width > (prefix_len + digits)) {
+			zeros = spec->width - (prefix_len + digits);
+		}
+	} else {
+		/* No zero padding */
+	}
+
+	spaces = spec->width - (prefix_len + zeros + digits);
+
+	sink_fill(sink, ' ', spaces);
+	sink_write(sink, prefix, prefix_len);
+	sink_fill(sink, '0', zeros);
+	sink_write(sink, end - digits, digits);
+}
+
+static void string_print(printf_sink_t *sink, const char *str,
+			 const fmt_spec_t *spec)
+{
+	int len = 0;
+
+	assert(str != NULL);
+
+	/* A precision gives the maximum number of characters to print */
+	while ((str[len] != '\0') && ((spec->prec < 0) || (len < spec->prec))) {
+		len++;
+	}
+
+	sink_fill(sink, ' ', spec->width - len);
+	sink_write(sink, str, len);
+}
+
+static const char *parse_decimal(const char *fmt, int *val)
+{
+	*val = 0;
+
+	while ((*fmt >= '0') && (*fmt <= '9')) {
+		*val = (*val * 10) + (*fmt - '0');
+		fmt++;
+	}
+
+	return fmt;
+}
+
+/*******************************************************************
+ * Reduced format print for Trusted firmware, shared by the printf
+ * and snprintf families.
+ * The following type specifiers are supported by this print
+ * %x - hexadecimal format
+ * %s - string format
+ * %d or %i - signed decimal format
+ * %u - unsigned decimal format
+ * %p - pointer format
+ *
+ * The following length specifiers are supported by this print
+ * %l - long int (64-bit on AArch64)
+ * %ll - long long int (64-bit on AArch64)
+ * %z - size_t sized integer formats (64 bit on AArch64)
+ *
+ * The following padding specifiers are supported by this print
+ * %0NN - Left-pad the number with 0s (NN is a decimal number)
+ * %NN - Left-pad the field with spaces (NN is a decimal number)
+ * %.NN - Minimum number of digits for numbers, or maximum number
+ *        of characters for strings (NN is a decimal number)
+ *
+ * The print exits on all other formats specifiers other than valid
+ * combinations of the above specifiers.
+ *******************************************************************/
+int printf_format(printf_sink_t *sink, const char *fmt, va_list args)
+{
+	int l_count;
+	long long int num;
+	unsigned long long int unum;
+	fmt_spec_t spec;
+
+	while (*fmt != '\0') {
+		if (*fmt != '%') {
+			sink_putc(sink, *fmt);
+			fmt++;
+			continue;
+		}
+
+		fmt++;
+		l_count = 0;
+		spec.padc = ' ';
+		spec.prec = -1;
+
+		/* Flags, field width and precision */
+		if (*fmt == '0') {
+			spec.padc = '0';
+			fmt++;
+		}
+
+		fmt = parse_decimal(fmt, &spec.width);
+
+		if (*fmt == '.') {
+			fmt = parse_decimal(fmt + 1, &spec.prec);
+		}
+
+		/* Length modifiers */
+		for (;;) {
+			if (*fmt == 'l') {
+				l_count++;
+			} else if (*fmt == 'z') {
+				if (sizeof(size_t) == 8U) {
+					l_count = 2;
+				}
+			} else {
+				break;
+			}
+			fmt++;
+		}
+
+		/* Check the format specifier */
+		switch (*fmt) {
+		case 'i': /* Fall through to next one */
+		case 'd':
+			num = get_num_va_args(args, l_count);
+			if (num < 0) {
+				unum = 0ULL - (unsigned long long int)num;
+				num_print(sink, unum, 10U, "-", &spec);
+			} else {
+				unum = (unsigned long long int)num;
+				num_print(sink, unum, 10U, "", &spec);
+			}
+			break;
+		case 's':
+			string_print(sink, va_arg(args, char *), &spec);
+			break;
+		case 'p':
+			unum = (uintptr_t)va_arg(args, void *);
+			num_print(sink, unum, 16U, "0x", &spec);
+			break;
+		case 'x':
+			unum = get_unum_va_args(args, l_count);
+			num_print(sink, unum, 16U, "", &spec);
+			break;
+		case 'u':
+			unum = get_unum_va_args(args, l_count);
+			num_print(sink, unum, 10U, "", &spec);
+			break;
+		default:
+			/* Exit on any other format specifier */
+			return -1;
+		}
+		fmt++;
+	}
+
+	return (int)sink->count;
+}
@@ -0,0 +1,35 @@
+/*
+ * Copyright (c) 2019, ARM Limited and Contributors. All rights reserved.
+ *
+ * SPDX-License-Identifier: BSD-3-Clause
+ */
+
+#ifndef PRINTF_PRIVATE_H
+#define PRINTF_PRIVATE_H
+
+#include <stdarg.h>
+#include <stddef.h>
+
+/*
+ * Output sink used by the common formatter. Characters are accumulated in
+ * 'buf' and handed over to 'flush' once 'size' characters are held, so that
+ * the consumer sees chunks rather than individual characters. If 'flush' is
+ * NULL, characters that do not fit in the buffer are discarded but still
+ * counted, which gives snprintf() semantics.
+ */
+typedef struct printf_sink {
+	char *buf;
+	size_t len;
+	size_t size;
+	size_t count;
+	void (*flush)(struct printf_sink *sink);
+} printf_sink_t;
+
+/*
+ * Formats 'fmt' into 'sink'. Returns the number of characters produced, or
+ * -1 if an unsupported format specifier is found. The sink is not flushed
+ * on return, that is left to the caller.
+ */
+int printf_format(printf_sink_t *sink, const char *fmt, va_list args);
+
+#endif /* PRINTF_PRIVATE_H */
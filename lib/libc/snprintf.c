@@ -1,60 +1,22 @@
 /*
- * Copyright (c) 2017-2018, ARM Limited and Contributors. All rights reserved.
+ * Copyright (c) 2017-2019, ARM Limited and Contributors. All rights reserved.
  *
  * SPDX-License-Identifier: BSD-3-Clause
  */
 
 #include <assert.h>
 #include <stdarg.h>
+#include <stdio.h>
 
 #include <common/debug.h>
 #include <plat/common/platform.h>
 
-static void string_print(char **s, size_t n, size_t *chars_printed,
-			 const char *str)
-{
-	while (*str != '\0') {
-		if (*chars_printed < n) {
-			*(*s) = *str;
-			(*s)++;
-		}
-
-		(*chars_printed)++;
-		str++;
-	}
-}
-
-static void unsigned_dec_print(char **s, size_t n, size_t *chars_printed,
-			       unsigned int unum)
-{
-	/* Enough for a 32-bit unsigned decimal integer (4294967295). */
-	char num_buf[10];
-	int i = 0;
-	unsigned int rem;
-
-	do {
-		rem = unum % 10U;
-		num_buf[i++] = '0' + rem;
-		unum /= 10U;
-	} while (unum > 0U);
-
-	while (--i >= 0) {
-		if (*chars_printed < n) {
-			*(*s) = num_buf[i];
-			(*s)++;
-		}
-
-		(*chars_printed)++;
-	}
-}
+#include "printf_private.h"
 
 /*******************************************************************
- * Reduced snprintf to be used for Trusted firmware.
- * The following type specifiers are supported:
- *
- * %d or %i - signed decimal format
- * %s - string format
- * %u - unsigned decimal format
+ * Reduced vsnprintf to be used for Trusted firmware.
+ * It supports the same format specifiers as printf(), see
+ * printf_format() for the list.
  *
  * The function panics on all other formats specifiers.
  *
@@ -62,82 +24,41 @@ static void unsigned_dec_print(char **s, size_t n, size_t *chars_printed,
  * buffer was big enough. If it returns a value lower than n, the
  * whole string has been written.
  *******************************************************************/
-int snprintf(char *s, size_t n, const char *fmt, ...)
+int vsnprintf(char *s, size_t n, const char *fmt, va_list args)
 {
-	va_list args;
-	int num;
-	unsigned int unum;
-	char *str;
-	size_t chars_printed = 0U;
-
-	if (n == 0U) {
-		/* There isn't space for anything. */
-	} else if (n == 1U) {
-		/* Buffer is too small to actually write anything else. */
-		*s = '\0';
-		n = 0U;
-	} else {
+	printf_sink_t sink = {
+		.buf = s,
+		.len = 0U,
 		/* Reserve space for the terminator character. */
-		n--;
+		.size = (n > 0U) ? (n - 1U) : 0U,
+		.count = 0U,
+		.flush = NULL
+	};
+	int count;
+
+	count = printf_format(&sink, fmt, args);
+	if (count < 0) {
+		/* Panic on any unsupported format specifier. */
+		ERROR("snprintf: unsupported format specifier in \"%s\"\n", fmt);
+		plat_panic_handler();
+		assert(0); /* Unreachable */
 	}
 
-	va_start(args, fmt);
-	while (*fmt != '\0') {
-
-		if (*fmt == '%') {
-			fmt++;
-			/* Check the format specifier. */
-			switch (*fmt) {
-			case 'i':
-			case 'd':
-				num = va_arg(args, int);
-
-				if (num < 0) {
-					if (chars_printed < n) {
-						*s = '-';
-						s++;
-					}
-					chars_printed++;
-
-					unum = (unsigned int)-num;
-				} else {
-					unum = (unsigned int)num;
-				}
-
-				unsigned_dec_print(&s, n, &chars_printed, unum);
-				break;
-			case 's':
-				str = va_arg(args, char *);
-				string_print(&s, n, &chars_printed, str);
-				break;
-			case 'u':
-				unum = va_arg(args, unsigned int);
-				unsigned_dec_print(&s, n, &chars_printed, unum);
-				break;
-			default:
-				/* Panic on any other format specifier. */
-				ERROR("snprintf: specifier with ASCII code '%d' not supported.",
-				      *fmt);
-				plat_panic_handler();
-				assert(0); /* Unreachable */
-			}
-			fmt++;
-			continue;
-		}
+	if (n > 0U) {
+		s[sink.len] = '\0';
+	}
 
-		if (chars_printed < n) {
-			*s = *fmt;
-			s++;
-		}
+	return count;
+}
 
-		fmt++;
-		chars_printed++;
-	}
+int snprintf(char *s, size_t n, const char *fmt, ...)
+{
+	int count;
+	va_list args;
 
+	va_start(args, fmt);
+	count = vsnprintf(s, n, fmt, args);
 	va_end(args);
 
-	if (n > 0U)
-		*s = '\0';
-
-	return (int)chars_printed;
+	return count;
 }
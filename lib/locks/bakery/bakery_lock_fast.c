@@ -0,0 +1,167 @@
+/*
+ * Copyright (c) 2019, ARM Limited and Contributors. All rights reserved.
+ *
+ * SPDX-License-Identifier: BSD-3-Clause
+ */
+
+#include <assert.h>
+
+#include <arch_helpers.h>
+#include <lib/bakery_lock.h>
+#include <lib/cassert.h>
+#include <lib/utils_def.h>
+#include <plat/common/platform.h>
+
+/*
+ * Functions in this file implement Lamport's fast mutual exclusion algorithm
+ * ("A Fast Mutual Exclusion Algorithm", ACM TOCS 5(1), 1987) behind the bakery
+ * lock interface.
+ *
+ * Like the Bakery algorithm, it only relies on single-copy atomic loads and
+ * stores. With USE_COHERENT_MEM, the lock data structures are in coherent
+ * memory, which is fully ordered, so contenders don't need address
+ * translation enabled. Otherwise, they are in cacheable and Normal memory,
+ * which is only coherent for all contenders with HW_ASSISTED_COHERENCY, and
+ * barriers order the stores of a contender before its following loads.
+ *
+ * Unlike the Bakery algorithm, acquiring and releasing a lock that isn't
+ * contended takes a constant number of accesses, regardless of the number of
+ * CPUs. The data of all the CPUs is only read when the lock is contended.
+ * This comes at the cost of fairness: the algorithm is free of deadlocks, but
+ * a contender may in theory be overtaken indefinitely, as with spinlocks.
+ *
+ * The 'lock_data' entry of each CPU is set while it contends for the lock or
+ * holds it. 'fast_last' and 'fast_owner' hold 1 + the index of a CPU, or 0.
+ * In Normal memory, the entry of each CPU is in its own copy of the lock, and
+ * the shared variables are those of the copy of CPU 0.
+ */
+
+#if USE_COHERENT_MEM
+static inline volatile uint16_t *bakery_entry(bakery_lock_t *bakery,
+					      unsigned int cpu_ix)
+{
+	return &bakery->lock_data[cpu_ix];
+}
+
+/* Coherent memory is not reordered */
+static inline void bakery_fence(void)
+{
+}
+#else
+#ifdef PLAT_PERCPU_BAKERY_LOCK_SIZE
+CASSERT((PLAT_PERCPU_BAKERY_LOCK_SIZE & (CACHE_WRITEBACK_GRANULE - 1)) == 0, \
+	PLAT_PERCPU_BAKERY_LOCK_SIZE_not_cacheline_multiple);
+#define PERCPU_BAKERY_LOCK_SIZE (PLAT_PERCPU_BAKERY_LOCK_SIZE)
+#else
+IMPORT_SYM(uintptr_t, __PERCPU_BAKERY_LOCK_START__, BAKERY_LOCK_START);
+IMPORT_SYM(uintptr_t, __PERCPU_BAKERY_LOCK_END__, BAKERY_LOCK_END);
+#define PERCPU_BAKERY_LOCK_SIZE (BAKERY_LOCK_END - BAKERY_LOCK_START)
+#endif
+
+static inline volatile uint16_t *bakery_entry(bakery_lock_t *bakery,
+					      unsigned int cpu_ix)
+{
+	return &((bakery_info_t *)((uintptr_t)bakery +
+			cpu_ix * PERCPU_BAKERY_LOCK_SIZE))->lock_data;
+}
+
+/* The algorithm requires the stores to be observed before the next loads */
+static inline void bakery_fence(void)
+{
+	dmbish();
+}
+#endif
+
+#define assert_bakery_entry_valid(_entry, _bakery) do {	\
+	assert((_bakery) != NULL);			\
+	assert((_entry) < BAKERY_LOCK_MAX_CPUS);	\
+} while (false)
+
+/* Make the stores above visible before waking up the waiting contenders */
+static inline void bakery_signal(void)
+{
+	dsb();
+	sev();
+}
+
+void bakery_lock_get(bakery_lock_t *bakery)
+{
+	unsigned int me, they;
+	uint16_t my_id;
+
+	me = plat_my_core_pos();
+	my_id = (uint16_t)(me + 1U);
+
+	assert_bakery_entry_valid(me, bakery);
+
+	/* Prevent recursive acquisition */
+	assert(*bakery_entry(bakery, me) == 0U);
+
+	for (;;) {
+		*bakery_entry(bakery, me) = 1U;
+		bakery->fast_last = my_id;
+		bakery_fence();
+
+		if (bakery->fast_owner != 0U) {
+			/* The lock is held or being acquired, wait for it */
+			*bakery_entry(bakery, me) = 0U;
+			bakery_signal();
+			while (bakery->fast_owner != 0U)
+				wfe();
+			continue;
+		}
+
+		bakery->fast_owner = my_id;
+		bakery_fence();
+
+		/* No other contender went through the door after us */
+		if (bakery->fast_last == my_id)
+			break;
+
+		/*
+		 * Contention: wait for the other contenders to either back off
+		 * or release the lock. The lock belongs to the last one to
+		 * have closed the door.
+		 */
+		*bakery_entry(bakery, me) = 0U;
+		bakery_signal();
+		for (they = 0U; they < BAKERY_LOCK_MAX_CPUS; they++) {
+			while (*bakery_entry(bakery, they) != 0U)
+				wfe();
+		}
+
+		if (bakery->fast_owner == my_id) {
+			*bakery_entry(bakery, me) = 1U;
+			break;
+		}
+
+		while (bakery->fast_owner != 0U)
+			wfe();
+	}
+
+	/*
+	 * Lock acquired. Ensure that any reads from a shared resource in the
+	 * critical section read values after the lock is acquired.
+	 */
+	dmbld();
+}
+
+/* Release the lock and signal contenders */
+void bakery_lock_release(bakery_lock_t *bakery)
+{
+	unsigned int me = plat_my_core_pos();
+
+	assert_bakery_entry_valid(me, bakery);
+	assert(*bakery_entry(bakery, me) != 0U);
+
+	/*
+	 * Ensure that other observers see any stores in the critical section
+	 * before releasing the lock. Release the lock by opening the door and
+	 * resetting the entry of this CPU. Then signal other waiting
+	 * contenders.
+	 */
+	dmbst();
+	bakery->fast_owner = 0U;
+	*bakery_entry(bakery, me) = 0U;
+	bakery_signal();
+}
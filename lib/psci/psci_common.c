@@ -4,6 +4,8 @@
  * SPDX-License-Identifier: BSD-3-Clause
  */
 
+#define LOG_CATEGORY	LOG_CAT_PSCI
+
 #include <assert.h>
 #include <string.h>
 
@@ -12,6 +14,9 @@
 #include <common/bl_common.h>
 #include <common/debug.h>
 #include <context.h>
+#if PSCI_REQ_STATE_COUNTERS
+#include <lib/atomic.h>
+#endif
 #include <lib/el3_runtime/context_mgmt.h>
 #include <lib/utils.h>
 #include <plat/common/platform.h>
@@ -35,14 +40,41 @@ const spd_pm_ops_t *psci_spd_pm;
  * local states requested for a particular non cpu power domain by each cpu
  * within the domain.
  *
- * TODO: Dense packing of the requested states will cause cache thrashing
- * when multiple power domains write to it. If we allocate the requested
- * states at each power level in a cache-line aligned per-domain memory,
- * the cache thrashing can be avoided.
+ * Dense packing of the requested states causes cache thrashing when CPUs
+ * request states concurrently. With PSCI_PADDED_REQ_STATES, the states
+ * requested by each CPU are in a cache line of their own instead, and state
+ * coordination gathers them in an array for the platform.
  */
+#if PSCI_PADDED_REQ_STATES
+typedef struct psci_cpu_req_local_pwr_states {
+	plat_local_state_t pwr_state[PLAT_MAX_PWR_LVL];
+} __aligned(CACHE_WRITEBACK_GRANULE) psci_cpu_req_local_pwr_states_t;
+
+static psci_cpu_req_local_pwr_states_t
+	psci_req_local_pwr_states[PLATFORM_CORE_COUNT];
+
+#define psci_req_local_pwr_state(_lvl, _cpu)	\
+	(psci_req_local_pwr_states[(_cpu)].pwr_state[(_lvl) - 1U])
+#else
 static plat_local_state_t
 	psci_req_local_pwr_states[PLAT_MAX_PWR_LVL][PLATFORM_CORE_COUNT];
 
+#define psci_req_local_pwr_state(_lvl, _cpu)	\
+	(psci_req_local_pwr_states[(_lvl) - 1U][(_cpu)])
+#endif
+
+#if PSCI_REQ_STATE_COUNTERS
+/*
+ * Number of CPUs requesting each local power state for each non CPU power
+ * domain, so that the coordinated state is found without reading the requested
+ * state of every CPU. The counters are updated with atomic operations, which
+ * are not supported on the coherent memory that may hold the power domain
+ * nodes, hence the separate array.
+ */
+static volatile uint32_t psci_req_local_pwr_state_counts
+	[PSCI_NUM_NON_CPU_PWR_DOMAINS][PLAT_MAX_OFF_STATE + 1U];
+#endif
+
 
 /*******************************************************************************
  * Arrays that hold the platform's power domain tree information for state
@@ -67,6 +99,13 @@ cpu_pd_node_t psci_cpu_pd_nodes[PLATFORM_CORE_COUNT];
  ******************************************************************************/
 const plat_psci_ops_t *psci_plat_pm_ops;
 
+#if PSCI_OS_INIT_MODE
+/*******************************************************************************
+ * The suspend mode set by PSCI_SET_SUSPEND_MODE, platform-coordinated at boot.
+ ******************************************************************************/
+suspend_mode_t psci_suspend_mode = PLAT_COORD;
+#endif
+
 /******************************************************************************
  * Check that the maximum power level supported by the platform makes sense
  *****************************************************************************/
@@ -174,6 +213,24 @@ unsigned int psci_is_last_on_cpu(void)
 	return 1;
 }
 
+#if PSCI_OS_INIT_MODE
+/*******************************************************************************
+ * This function verifies that all the CPUs in the system are ON. Returns 1
+ * (true) if they are or 0 (false) otherwise.
+ ******************************************************************************/
+unsigned int psci_are_all_cpus_on(void)
+{
+	int cpu_idx;
+
+	for (cpu_idx = 0; cpu_idx < PLATFORM_CORE_COUNT; cpu_idx++) {
+		if (psci_get_aff_info_state_by_idx(cpu_idx) != AFF_STATE_ON)
+			return 0;
+	}
+
+	return 1;
+}
+#endif
+
 /*******************************************************************************
  * Routine to return the maximum power level to traverse to after a cpu has
  * been physically powered up. It is expected to be called immediately after
@@ -199,19 +256,44 @@ static unsigned int get_power_on_target_pwrlvl(void)
  * Helper function to update the requested local power state array. This array
  * does not store the requested state for the CPU power level. Hence an
  * assertion is added to prevent us from accessing the wrong index.
+ *
+ * 'parent_idx' is the power domain node at 'pwrlvl' that is an ancestor of the
+ * CPU. With PSCI_REQ_STATE_COUNTERS, its counters are updated too. The new
+ * state is counted before the old one is discounted, so that a concurrent
+ * reader never misses a shallower state.
  *****************************************************************************/
 static void psci_set_req_local_pwr_state(unsigned int pwrlvl,
 					 unsigned int cpu_idx,
+					 unsigned int parent_idx,
 					 plat_local_state_t req_pwr_state)
 {
+#if PSCI_REQ_STATE_COUNTERS
+	plat_local_state_t old_pwr_state;
+#endif
+
 	/*
 	 * This should never happen, we have this here to avoid
 	 * "array subscript is above array bounds" errors in GCC.
 	 */
 	assert(pwrlvl > PSCI_CPU_PWR_LVL);
+	assert(psci_non_cpu_pd_nodes[parent_idx].level == pwrlvl);
 #pragma GCC diagnostic push
 #pragma GCC diagnostic ignored "-Warray-bounds"
-	psci_req_local_pwr_states[pwrlvl - 1U][cpu_idx] = req_pwr_state;
+#if PSCI_REQ_STATE_COUNTERS
+	old_pwr_state = psci_req_local_pwr_state(pwrlvl, cpu_idx);
+	if (old_pwr_state == req_pwr_state)
+		return;
+
+	assert(req_pwr_state <= PLAT_MAX_OFF_STATE);
+	atomic_add_u32(
+		&psci_req_local_pwr_state_counts[parent_idx][req_pwr_state], 1U);
+#endif
+	psci_req_local_pwr_state(pwrlvl, cpu_idx) = req_pwr_state;
+#if PSCI_REQ_STATE_COUNTERS
+	atomic_add_u32(
+		&psci_req_local_pwr_state_counts[parent_idx][old_pwr_state],
+		(uint32_t)-1);
+#endif
 #pragma GCC diagnostic pop
 }
 
@@ -223,15 +305,69 @@ void __init psci_init_req_local_pwr_states(void)
 	/* Initialize the requested state of all non CPU power domains as OFF */
 	unsigned int pwrlvl;
 	int core;
+#if PSCI_REQ_STATE_COUNTERS
+	unsigned int node;
+#endif
 
-	for (pwrlvl = 0U; pwrlvl < PLAT_MAX_PWR_LVL; pwrlvl++) {
+	for (pwrlvl = PSCI_CPU_PWR_LVL + 1U; pwrlvl <= PLAT_MAX_PWR_LVL;
+	     pwrlvl++) {
 		for (core = 0; core < PLATFORM_CORE_COUNT; core++) {
-			psci_req_local_pwr_states[pwrlvl][core] =
+			psci_req_local_pwr_state(pwrlvl, core) =
 				PLAT_MAX_OFF_STATE;
 		}
 	}
+
+#if PSCI_REQ_STATE_COUNTERS
+	for (node = 0U; node < PSCI_NUM_NON_CPU_PWR_DOMAINS; node++) {
+		psci_req_local_pwr_state_counts[node][PLAT_MAX_OFF_STATE] =
+			psci_non_cpu_pd_nodes[node].ncpus;
+	}
+#endif
+}
+
+#if PSCI_REQ_STATE_COUNTERS
+/******************************************************************************
+ * Helper function to return the shallowest local power state requested by the
+ * cpus of which the power domain 'parent_idx' is an ancestor. This is the
+ * target state chosen by the default plat_get_target_pwr_state(), found in a
+ * number of steps bounded by PLAT_MAX_OFF_STATE rather than the number of
+ * cpus.
+ *****************************************************************************/
+static plat_local_state_t psci_get_min_req_local_pwr_state(
+						unsigned int parent_idx)
+{
+	plat_local_state_t state;
+
+	for (state = PSCI_LOCAL_STATE_RUN; state < PLAT_MAX_OFF_STATE; state++) {
+		if (psci_req_local_pwr_state_counts[parent_idx][state] != 0U)
+			break;
+	}
+
+	return state;
 }
+#elif PSCI_PADDED_REQ_STATES
+/******************************************************************************
+ * Helper function to copy the local power states requested by the 'ncpus' cpus
+ * from 'cpu_idx' for a power domain at 'pwrlvl' to the array 'req_states'.
+ * These requested states will be used to determine a suitable target state for
+ * this power domain during psci state coordination. An assertion is added to
+ * prevent us from accessing the CPU power level.
+ *****************************************************************************/
+static void psci_copy_req_local_pwr_states(unsigned int pwrlvl,
+					   int cpu_idx,
+					   unsigned int ncpus,
+					   plat_local_state_t *req_states)
+{
+	unsigned int i;
 
+	assert(pwrlvl > PSCI_CPU_PWR_LVL);
+	assert(((unsigned int)cpu_idx + ncpus) <= PLATFORM_CORE_COUNT);
+
+	for (i = 0U; i < ncpus; i++)
+		req_states[i] = psci_req_local_pwr_state(pwrlvl,
+						(unsigned int)cpu_idx + i);
+}
+#else
 /******************************************************************************
  * Helper function to return a reference to an array containing the local power
  * states requested by each cpu for a power domain at 'pwrlvl'. The size of the
@@ -245,8 +381,9 @@ static plat_local_state_t *psci_get_req_local_pwr_states(unsigned int pwrlvl,
 {
 	assert(pwrlvl > PSCI_CPU_PWR_LVL);
 
-	return &psci_req_local_pwr_states[pwrlvl - 1U][cpu_idx];
+	return &psci_req_local_pwr_state(pwrlvl, cpu_idx);
 }
+#endif
 
 /*
  * psci_non_cpu_pd_nodes can be placed either in normal memory or coherent
@@ -382,9 +519,26 @@ void psci_set_pwr_domains_to_run(unsigned int end_pwrlvl)
 				PSCI_LOCAL_STATE_RUN);
 		psci_set_req_local_pwr_state(lvl,
 					     cpu_idx,
+					     parent_idx,
+					     PSCI_LOCAL_STATE_RUN);
+		parent_idx = psci_non_cpu_pd_nodes[parent_idx].parent_node;
+	}
+
+#if PSCI_OS_INIT_MODE
+	/*
+	 * In OS-initiated mode, the requested state of the levels above the
+	 * suspend level may have been updated too, see
+	 * psci_validate_state_coordination(). Their locks are not held, as in
+	 * psci_do_state_coordination() after the target state RUN is found.
+	 */
+	for (; lvl <= PLAT_MAX_PWR_LVL; lvl++) {
+		psci_set_req_local_pwr_state(lvl,
+					     cpu_idx,
+					     parent_idx,
 					     PSCI_LOCAL_STATE_RUN);
 		parent_idx = psci_non_cpu_pd_nodes[parent_idx].parent_node;
 	}
+#endif
 
 	/* Set the affinity info state to ON */
 	psci_set_aff_info_state(AFF_STATE_ON);
@@ -393,6 +547,43 @@ void psci_set_pwr_domains_to_run(unsigned int end_pwrlvl)
 	psci_flush_cpu_data(psci_svc_cpu_data);
 }
 
+/******************************************************************************
+ * Helper function to return the target local power state of the power domain
+ * 'parent_idx' at 'pwrlvl', coordinated amongst the local power states
+ * requested by the cpus of which it is an ancestor.
+ *****************************************************************************/
+static plat_local_state_t psci_get_target_pwr_state(unsigned int pwrlvl,
+						    unsigned int parent_idx)
+{
+#if PSCI_REQ_STATE_COUNTERS
+	/* The target state is the shallowest requested state */
+	return psci_get_min_req_local_pwr_state(parent_idx);
+#else
+	int start_idx;
+	unsigned int ncpus;
+#if PSCI_PADDED_REQ_STATES
+	plat_local_state_t req_states[PLATFORM_CORE_COUNT];
+#else
+	plat_local_state_t *req_states;
+#endif
+
+	/* Get the requested power states for this power level */
+	start_idx = psci_non_cpu_pd_nodes[parent_idx].cpu_start_idx;
+	ncpus = psci_non_cpu_pd_nodes[parent_idx].ncpus;
+#if PSCI_PADDED_REQ_STATES
+	psci_copy_req_local_pwr_states(pwrlvl, start_idx, ncpus, req_states);
+#else
+	req_states = psci_get_req_local_pwr_states(pwrlvl, start_idx);
+#endif
+
+	/*
+	 * Let the platform coordinate amongst the requested states at
+	 * this power level and return the target local power state.
+	 */
+	return plat_get_target_pwr_state(pwrlvl, req_states, ncpus);
+#endif
+}
+
 /******************************************************************************
  * This function is passed the local power states requested for each power
  * domain (state_info) between the current CPU domain and its ancestors until
@@ -410,42 +601,43 @@ void psci_set_pwr_domains_to_run(unsigned int end_pwrlvl)
  * The 'state_info' is updated with the target state for each level between the
  * CPU and the 'end_pwrlvl' and returned to the caller.
  *
+ * The caller holds the locks of the power domains up to 'locked_lvl', as taken
+ * by psci_acquire_pwr_domain_locks(). With PSCI_HIERARCHICAL_LOCKS, this is
+ * psci_first_locked_lvl(end_pwrlvl), and the locks of the higher levels are
+ * only taken when the level below is not negotiated to RUN, i.e. when this CPU
+ * is the last one to power down the power domain below. The function returns
+ * the highest level whose lock is held, to be passed to
+ * psci_release_pwr_domain_locks().
+ *
  * This function will only be invoked with data cache enabled and while
  * powering down a core.
  *****************************************************************************/
-void psci_do_state_coordination(unsigned int end_pwrlvl,
-				psci_power_state_t *state_info)
+unsigned int psci_do_state_coordination(unsigned int end_pwrlvl,
+					unsigned int locked_lvl,
+					psci_power_state_t *state_info)
 {
 	unsigned int lvl, parent_idx, cpu_idx = plat_my_core_pos();
-	int start_idx;
-	unsigned int ncpus;
-	plat_local_state_t target_state, *req_states;
 
 	assert(end_pwrlvl <= PLAT_MAX_PWR_LVL);
+	assert(locked_lvl <= end_pwrlvl);
 	parent_idx = psci_cpu_pd_nodes[cpu_idx].parent_node;
 
 	/* For level 0, the requested state will be equivalent
 	   to target state */
 	for (lvl = PSCI_CPU_PWR_LVL + 1U; lvl <= end_pwrlvl; lvl++) {
 
+		/* Locks are taken in order of increasing power domain level */
+		if (lvl > locked_lvl) {
+			psci_lock_get(&psci_non_cpu_pd_nodes[parent_idx]);
+			locked_lvl = lvl;
+		}
+
 		/* First update the requested power state */
-		psci_set_req_local_pwr_state(lvl, cpu_idx,
+		psci_set_req_local_pwr_state(lvl, cpu_idx, parent_idx,
 					     state_info->pwr_domain_state[lvl]);
 
-		/* Get the requested power states for this power level */
-		start_idx = psci_non_cpu_pd_nodes[parent_idx].cpu_start_idx;
-		req_states = psci_get_req_local_pwr_states(lvl, start_idx);
-
-		/*
-		 * Let the platform coordinate amongst the requested states at
-		 * this power level and return the target local power state.
-		 */
-		ncpus = psci_non_cpu_pd_nodes[parent_idx].ncpus;
-		target_state = plat_get_target_pwr_state(lvl,
-							 req_states,
-							 ncpus);
-
-		state_info->pwr_domain_state[lvl] = target_state;
+		state_info->pwr_domain_state[lvl] =
+			psci_get_target_pwr_state(lvl, parent_idx);
 
 		/* Break early if the negotiated target power state is RUN */
 		if (is_local_state_run(state_info->pwr_domain_state[lvl]) != 0)
@@ -459,17 +651,133 @@ void psci_do_state_coordination(unsigned int end_pwrlvl,
 	 * the target power state is RUN at a power level < end_pwlvl.
 	 * We update the requested power state from state_info and then
 	 * set the target state as RUN.
+	 *
+	 * The locks of these levels may not be held. The requested state of
+	 * this CPU can still be updated, as a CPU coordinating one of these
+	 * levels also finds the requested state RUN of a running CPU in the
+	 * power domain negotiated to RUN.
 	 */
 	for (lvl = lvl + 1U; lvl <= end_pwrlvl; lvl++) {
-		psci_set_req_local_pwr_state(lvl, cpu_idx,
+		parent_idx = psci_non_cpu_pd_nodes[parent_idx].parent_node;
+		psci_set_req_local_pwr_state(lvl, cpu_idx, parent_idx,
 					     state_info->pwr_domain_state[lvl]);
 		state_info->pwr_domain_state[lvl] = PSCI_LOCAL_STATE_RUN;
 
 	}
 
-	/* Update the target state in the power domain nodes */
+	/*
+	 * Update the target state in the power domain nodes. The nodes above
+	 * 'locked_lvl' are already in the RUN state.
+	 */
+	psci_set_target_local_pwr_states(locked_lvl, state_info);
+
+	return locked_lvl;
+}
+
+#if PSCI_OS_INIT_MODE
+/******************************************************************************
+ * Helper function to check that all the cpus of which the power domain
+ * 'parent_idx' is an ancestor, apart from the current one, are idle, i.e. that
+ * the current cpu is the last one to go idle in this power domain.
+ *****************************************************************************/
+static bool psci_is_last_cpu_to_idle(unsigned int parent_idx,
+				     unsigned int my_idx)
+{
+	unsigned int cpu_idx, start_idx, ncpus;
+
+	start_idx = (unsigned int)psci_non_cpu_pd_nodes[parent_idx].cpu_start_idx;
+	ncpus = psci_non_cpu_pd_nodes[parent_idx].ncpus;
+
+	for (cpu_idx = start_idx; cpu_idx < (start_idx + ncpus); cpu_idx++) {
+		if (cpu_idx == my_idx)
+			continue;
+
+		if (is_local_state_run(
+			psci_get_cpu_local_state_by_idx((int)cpu_idx)) != 0)
+			return false;
+	}
+
+	return true;
+}
+
+/******************************************************************************
+ * This function is the OS-initiated mode counterpart of
+ * psci_do_state_coordination(). The OS chooses the state of each power domain
+ * and the request of the current CPU is only accepted if it is the target state
+ * that the platform would have coordinated for each level until 'end_pwrlvl':
+ * the request is denied if the target state of a level is RUN, i.e. if a CPU of
+ * the power domain is still running, and rejected as invalid if the request is
+ * deeper than allowed by the other CPUs. The current CPU must also be the last
+ * one to go idle in the power domain at 'end_pwrlvl'.
+ *
+ * The power domains above 'end_pwrlvl' are not powered down by this request.
+ * The current CPU records its deepest requested state for them, which bounds
+ * the state the last CPU to go idle can request.
+ *
+ * On success, 'state_info' is left unchanged and the target states are set in
+ * the power domain nodes. On failure, the previous requested states are
+ * restored and an error code is returned.
+ *
+ * The caller holds the locks of the power domains up to 'end_pwrlvl'.
+ *****************************************************************************/
+int psci_validate_state_coordination(unsigned int end_pwrlvl,
+				     psci_power_state_t *state_info)
+{
+	unsigned int lvl, parent_idx, cpu_idx = plat_my_core_pos();
+	plat_local_state_t prev[PLAT_MAX_PWR_LVL];
+	plat_local_state_t req_state;
+	int rc = PSCI_E_SUCCESS;
+
+	assert(end_pwrlvl <= PLAT_MAX_PWR_LVL);
+
+	/* Save the previous requested states and update them */
+	parent_idx = psci_cpu_pd_nodes[cpu_idx].parent_node;
+	for (lvl = PSCI_CPU_PWR_LVL + 1U; lvl <= PLAT_MAX_PWR_LVL; lvl++) {
+		prev[lvl - 1U] = psci_req_local_pwr_state(lvl, cpu_idx);
+		req_state = state_info->pwr_domain_state[
+				(lvl <= end_pwrlvl) ? lvl : end_pwrlvl];
+		psci_set_req_local_pwr_state(lvl, cpu_idx, parent_idx,
+					     req_state);
+		parent_idx = psci_non_cpu_pd_nodes[parent_idx].parent_node;
+	}
+
+	/* Verify that the requested states match the target states */
+	parent_idx = psci_cpu_pd_nodes[cpu_idx].parent_node;
+	for (lvl = PSCI_CPU_PWR_LVL + 1U; lvl <= end_pwrlvl; lvl++) {
+		req_state = psci_get_target_pwr_state(lvl, parent_idx);
+		if (req_state != state_info->pwr_domain_state[lvl]) {
+			rc = (is_local_state_run(req_state) != 0) ?
+				PSCI_E_DENIED : PSCI_E_INVALID_PARAMS;
+			break;
+		}
+
+		/* Verify the last-man claim at the highest level */
+		if ((lvl == end_pwrlvl) &&
+		    !psci_is_last_cpu_to_idle(parent_idx, cpu_idx)) {
+			rc = PSCI_E_DENIED;
+			break;
+		}
+
+		parent_idx = psci_non_cpu_pd_nodes[parent_idx].parent_node;
+	}
+
+	if (rc != PSCI_E_SUCCESS) {
+		parent_idx = psci_cpu_pd_nodes[cpu_idx].parent_node;
+		for (lvl = PSCI_CPU_PWR_LVL + 1U; lvl <= PLAT_MAX_PWR_LVL;
+		     lvl++) {
+			psci_set_req_local_pwr_state(lvl, cpu_idx, parent_idx,
+						     prev[lvl - 1U]);
+			parent_idx =
+				psci_non_cpu_pd_nodes[parent_idx].parent_node;
+		}
+		return rc;
+	}
+
 	psci_set_target_local_pwr_states(end_pwrlvl, state_info);
+
+	return PSCI_E_SUCCESS;
 }
+#endif
 
 /******************************************************************************
  * This function validates a suspend request by making sure that if a standby
@@ -480,7 +788,8 @@ void psci_do_state_coordination(unsigned int end_pwrlvl,
  * state level X + 1 will enter.
  *
  * This validation will be enabled only for DEBUG builds as the platform is
- * expected to perform these validations as well.
+ * expected to perform these validations as well, except in OS-initiated mode
+ * where the requested state is not coordinated.
  *****************************************************************************/
 int psci_validate_suspend_req(const psci_power_state_t *state_info,
 			      unsigned int is_power_down_state)
@@ -946,6 +1255,16 @@ int psci_secondaries_brought_up(void)
  ******************************************************************************/
 void psci_do_pwrdown_sequence(unsigned int power_level)
 {
+#if CTX_WORLD_AFFINITY
+	/* The EL1 system registers of this CPU are lost on power down */
+	cm_el1_sysregs_context_invalidate();
+#endif
+
+#if CTX_LAZY_FPREGS
+	/* The FP registers of this CPU are lost on power down too */
+	cm_fpregs_context_flush();
+#endif
+
 #if HW_ASSISTED_COHERENCY
 	/*
 	 * With hardware-assisted coherency, the CPU drivers only initiate the
@@ -21,10 +21,13 @@ PSCI_LIB_SOURCES	:=	lib/el3_runtime/cpu_data_array.c	\
 				lib/psci/${ARCH}/psci_helpers.S
 
 ifeq (${ARCH}, aarch64)
-PSCI_LIB_SOURCES	+=	lib/el3_runtime/aarch64/context.S
+PSCI_LIB_SOURCES	+=	lib/el3_runtime/aarch64/context.S		\
+				lib/locks/exclusive/aarch64/atomic.S
 endif
 
-ifeq (${USE_COHERENT_MEM}, 1)
+ifeq (${USE_FAST_BAKERY_LOCK}, 1)
+PSCI_LIB_SOURCES		+=	lib/locks/bakery/bakery_lock_fast.c
+else ifeq (${USE_COHERENT_MEM}, 1)
 PSCI_LIB_SOURCES		+=	lib/locks/bakery/bakery_lock_coherent.c
 else
 PSCI_LIB_SOURCES		+=	lib/locks/bakery/bakery_lock_normal.c
@@ -4,6 +4,8 @@
  * SPDX-License-Identifier: BSD-3-Clause
  */
 
+#define LOG_CATEGORY	LOG_CAT_PSCI
+
 #include <assert.h>
 #include <string.h>
 
@@ -46,11 +48,149 @@ int psci_cpu_on(u_register_t target_cpu,
 	return psci_cpu_on_start(target_cpu, &ep);
 }
 
+/* Highest number of CPUs of a cluster that psci_cpu_on_many() can power on */
+#define PSCI_MASK_BITS		(sizeof(u_register_t) * 8U)
+#define PSCI_MAX_AFF0_COUNT	((PLATFORM_CORE_COUNT < PSCI_MASK_BITS) ? \
+				 (unsigned int)PLATFORM_CORE_COUNT :	\
+				 (unsigned int)PSCI_MASK_BITS)
+
+/*******************************************************************************
+ * Power on several CPUs of a cluster with a common entry point, on behalf of a
+ * platform service. The cluster is the one of 'target_cluster', whose Aff0
+ * field is ignored, and 'target_mask' has a bit set for the Aff0 value of each
+ * CPU to power on. The power on of each CPU is started as by CPU_ON, without
+ * waiting for the CPU to run, so that the CPUs power up concurrently when the
+ * platform allows it.
+ *
+ * A cluster has at most PLATFORM_CORE_COUNT CPUs, so 'target_mask' is rejected
+ * if it has a bit set for a higher Aff0 value.
+ *
+ * The bits of the CPUs whose power on was started are set in '*on_mask'. The
+ * function returns PSCI_E_SUCCESS if all the CPUs were powered on, or the
+ * error of the first one that could not be powered on otherwise.
+ ******************************************************************************/
+int psci_cpu_on_many(u_register_t target_cluster,
+		     u_register_t target_mask,
+		     uintptr_t entrypoint,
+		     u_register_t context_id,
+		     u_register_t *on_mask)
+{
+	int rc, ret = PSCI_E_SUCCESS;
+	unsigned int aff0;
+	u_register_t target_cpu, target_bit;
+	entry_point_info_t ep;
+
+	assert(on_mask != NULL);
+	*on_mask = 0U;
+
+	if ((PSCI_MAX_AFF0_COUNT < PSCI_MASK_BITS) &&
+	    ((target_mask >> PSCI_MAX_AFF0_COUNT) != 0U))
+		return PSCI_E_INVALID_PARAMS;
+
+	if ((psci_plat_pm_ops->pwr_domain_on == NULL) ||
+	    (psci_plat_pm_ops->pwr_domain_on_finish == NULL))
+		return PSCI_E_NOT_SUPPORTED;
+
+	/* The entry point is the same for all the CPUs */
+	rc = psci_validate_entry_point(&ep, entrypoint, context_id);
+	if (rc != PSCI_E_SUCCESS)
+		return rc;
+
+	target_cluster &= ~(MPIDR_AFFLVL_MASK << MPIDR_AFF0_SHIFT);
+
+	for (aff0 = 0U; aff0 < PSCI_MAX_AFF0_COUNT; aff0++) {
+		target_bit = (u_register_t)1U << aff0;
+		if ((target_mask & target_bit) == 0U)
+			continue;
+
+		target_cpu = target_cluster |
+			((u_register_t)aff0 << MPIDR_AFF0_SHIFT);
+
+		/* Determine if the cpu exists of not */
+		rc = psci_validate_mpidr(target_cpu);
+		if (rc == PSCI_E_SUCCESS)
+			rc = psci_cpu_on_start(target_cpu, &ep);
+		else
+			rc = PSCI_E_INVALID_PARAMS;
+
+		if (rc == PSCI_E_SUCCESS)
+			*on_mask |= target_bit;
+		else if (ret == PSCI_E_SUCCESS)
+			ret = rc;
+	}
+
+	return ret;
+}
+
 unsigned int psci_version(void)
 {
 	return PSCI_MAJOR_VER | PSCI_MINOR_VER;
 }
 
+#if PSCI_CPU_STANDBY_CACHE
+/*
+ * Last power_state parameter of each CPU that was validated as a CPU standby
+ * request, and the corresponding local state of the CPU power domain. Repeated
+ * requests for the same state skip the validation.
+ */
+typedef struct psci_cpu_standby_cache {
+	unsigned int power_state;
+	plat_local_state_t cpu_pd_state;
+	bool valid;
+} psci_cpu_standby_cache_t;
+
+static psci_cpu_standby_cache_t psci_cpu_standby_cache[PLATFORM_CORE_COUNT];
+#endif
+
+/*
+ * Enter the CPU standby state 'cpu_pd_state'. The higher power levels are not
+ * affected, so no lock nor state coordination is needed.
+ */
+static int psci_cpu_standby(plat_local_state_t cpu_pd_state)
+{
+#if ENABLE_PSCI_STAT
+	psci_power_state_t state_info = { {PSCI_LOCAL_STATE_RUN} };
+
+	state_info.pwr_domain_state[PSCI_CPU_PWR_LVL] = cpu_pd_state;
+#endif
+
+	/*
+	 * Set the state of the CPU power domain to the platform
+	 * specific retention state and enter the standby state.
+	 */
+	psci_set_cpu_local_state(cpu_pd_state);
+
+#if ENABLE_PSCI_STAT
+	plat_psci_stat_accounting_start(&state_info);
+#endif
+
+#if ENABLE_RUNTIME_INSTRUMENTATION
+	PMF_CAPTURE_TIMESTAMP(rt_instr_svc,
+	    RT_INSTR_ENTER_HW_LOW_PWR,
+	    PMF_NO_CACHE_MAINT);
+#endif
+
+	psci_plat_pm_ops->cpu_standby(cpu_pd_state);
+
+	/* Upon exit from standby, set the state back to RUN. */
+	psci_set_cpu_local_state(PSCI_LOCAL_STATE_RUN);
+
+#if ENABLE_RUNTIME_INSTRUMENTATION
+	PMF_CAPTURE_TIMESTAMP(rt_instr_svc,
+	    RT_INSTR_EXIT_HW_LOW_PWR,
+	    PMF_NO_CACHE_MAINT);
+#endif
+
+#if ENABLE_PSCI_STAT
+	plat_psci_stat_accounting_stop(&state_info);
+
+	/* Update PSCI stats */
+	psci_stats_update_pwr_up(PSCI_CPU_PWR_LVL, &state_info);
+#endif
+
+	return PSCI_E_SUCCESS;
+}
+
 int psci_cpu_suspend(unsigned int power_state,
 		     uintptr_t entrypoint,
 		     u_register_t context_id)
@@ -60,6 +200,14 @@ int psci_cpu_suspend(unsigned int power_state,
 	entry_point_info_t ep;
 	psci_power_state_t state_info = { {PSCI_LOCAL_STATE_RUN} };
 	plat_local_state_t cpu_pd_state;
+#if PSCI_CPU_STANDBY_CACHE
+	psci_cpu_standby_cache_t *cache =
+		&psci_cpu_standby_cache[plat_my_core_pos()];
+
+	/* Fast path for a CPU standby state validated earlier */
+	if (cache->valid && (cache->power_state == power_state))
+		return psci_cpu_standby(cache->cpu_pd_state);
+#endif
 
 	/* Validate the power_state parameter */
 	rc = psci_validate_power_state(power_state, &state_info);
@@ -73,6 +221,18 @@ int psci_cpu_suspend(unsigned int power_state,
 	 */
 	is_power_down_state = psci_get_pstate_type(power_state);
 
+#if PSCI_OS_INIT_MODE
+	/*
+	 * In OS-initiated mode, the composite state decoded from the StateID
+	 * is entered without coordination, so it must be consistent across
+	 * the power levels in all builds.
+	 */
+	if ((psci_suspend_mode == OS_INIT) &&
+	    (psci_validate_suspend_req(&state_info, is_power_down_state)
+			!= PSCI_E_SUCCESS))
+		return PSCI_E_INVALID_PARAMS;
+#endif
+
 	/* Sanity check the requested suspend levels */
 	assert(psci_validate_suspend_req(&state_info, is_power_down_state)
 			== PSCI_E_SUCCESS);
@@ -88,42 +248,15 @@ int psci_cpu_suspend(unsigned int power_state,
 		if  (psci_plat_pm_ops->cpu_standby == NULL)
 			return PSCI_E_INVALID_PARAMS;
 
-		/*
-		 * Set the state of the CPU power domain to the platform
-		 * specific retention state and enter the standby state.
-		 */
 		cpu_pd_state = state_info.pwr_domain_state[PSCI_CPU_PWR_LVL];
-		psci_set_cpu_local_state(cpu_pd_state);
-
-#if ENABLE_PSCI_STAT
-		plat_psci_stat_accounting_start(&state_info);
-#endif
 
-#if ENABLE_RUNTIME_INSTRUMENTATION
-		PMF_CAPTURE_TIMESTAMP(rt_instr_svc,
-		    RT_INSTR_ENTER_HW_LOW_PWR,
-		    PMF_NO_CACHE_MAINT);
+#if PSCI_CPU_STANDBY_CACHE
+		cache->power_state = power_state;
+		cache->cpu_pd_state = cpu_pd_state;
+		cache->valid = true;
 #endif
 
-		psci_plat_pm_ops->cpu_standby(cpu_pd_state);
-
-		/* Upon exit from standby, set the state back to RUN. */
-		psci_set_cpu_local_state(PSCI_LOCAL_STATE_RUN);
-
-#if ENABLE_RUNTIME_INSTRUMENTATION
-		PMF_CAPTURE_TIMESTAMP(rt_instr_svc,
-		    RT_INSTR_EXIT_HW_LOW_PWR,
-		    PMF_NO_CACHE_MAINT);
-#endif
-
-#if ENABLE_PSCI_STAT
-		plat_psci_stat_accounting_stop(&state_info);
-
-		/* Update PSCI stats */
-		psci_stats_update_pwr_up(PSCI_CPU_PWR_LVL, &state_info);
-#endif
-
-		return PSCI_E_SUCCESS;
+		return psci_cpu_standby(cpu_pd_state);
 	}
 
 	/*
@@ -140,14 +273,15 @@ int psci_cpu_suspend(unsigned int power_state,
 	 * Do what is needed to enter the power down state. Upon success,
 	 * enter the final wfi which will power down this CPU. This function
 	 * might return if the power down was abandoned for any reason, e.g.
-	 * arrival of an interrupt
+	 * arrival of an interrupt, or if the request was rejected in
+	 * OS-initiated mode.
 	 */
-	psci_cpu_suspend_start(&ep,
-			    target_pwrlvl,
-			    &state_info,
-			    is_power_down_state);
+	rc = psci_cpu_suspend_start(&ep,
+				    target_pwrlvl,
+				    &state_info,
+				    is_power_down_state);
 
-	return PSCI_E_SUCCESS;
+	return rc;
 }
 
 
@@ -187,12 +321,12 @@ int psci_system_suspend(uintptr_t entrypoint, u_register_t context_id)
 	 * might return if the power down was abandoned for any reason, e.g.
 	 * arrival of an interrupt
 	 */
-	psci_cpu_suspend_start(&ep,
-			    PLAT_MAX_PWR_LVL,
-			    &state_info,
-			    PSTATE_TYPE_POWERDOWN);
+	rc = psci_cpu_suspend_start(&ep,
+				    PLAT_MAX_PWR_LVL,
+				    &state_info,
+				    PSTATE_TYPE_POWERDOWN);
 
-	return PSCI_E_SUCCESS;
+	return rc;
 }
 
 int psci_cpu_off(void)
@@ -355,11 +489,10 @@ int psci_features(unsigned int psci_fid)
 	if ((psci_fid == PSCI_CPU_SUSPEND_AARCH32) ||
 	    (psci_fid == PSCI_CPU_SUSPEND_AARCH64)) {
 		/*
-		 * The trusted firmware does not support OS Initiated Mode.
+		 * OS Initiated Mode is only supported with PSCI_OS_INIT_MODE.
 		 */
 		unsigned int ret = ((FF_PSTATE << FF_PSTATE_SHIFT) |
-			(((FF_SUPPORTS_OS_INIT_MODE == 1U) ? 0U : 1U)
-				<< FF_MODE_SUPPORT_SHIFT));
+			(FF_SUPPORTS_OS_INIT_MODE << FF_MODE_SUPPORT_SHIFT));
 		return (int) ret;
 	}
 
@@ -367,6 +500,41 @@ int psci_features(unsigned int psci_fid)
 	return PSCI_E_SUCCESS;
 }
 
+#if PSCI_OS_INIT_MODE
+/*******************************************************************************
+ * Switch between the platform-coordinated and the OS-initiated suspend modes.
+ * The mode can only be changed to OS-initiated if all the CPUs are ON or the
+ * calling CPU is the last ON CPU, and to platform-coordinated if the calling
+ * CPU is the last ON CPU, so that no CPU is suspended in the previous mode.
+ ******************************************************************************/
+int psci_set_suspend_mode(unsigned int mode)
+{
+	int rc = PSCI_E_SUCCESS;
+	int idx = (int) plat_my_core_pos();
+
+	if ((mode != PLAT_COORD) && (mode != OS_INIT))
+		return PSCI_E_INVALID_PARAMS;
+
+	/* Prevent the other CPUs from changing their state during the checks */
+	psci_acquire_pwr_domain_locks(PLAT_MAX_PWR_LVL, idx);
+
+	if (mode == psci_suspend_mode)
+		goto exit;
+
+	if (psci_is_last_on_cpu() != 0U)
+		psci_suspend_mode = (suspend_mode_t)mode;
+	else if ((mode == OS_INIT) && (psci_are_all_cpus_on() != 0U))
+		psci_suspend_mode = OS_INIT;
+	else
+		rc = PSCI_E_DENIED;
+
+exit:
+	psci_release_pwr_domain_locks(PLAT_MAX_PWR_LVL, idx);
+
+	return rc;
+}
+#endif
+
 /*******************************************************************************
  * PSCI top level handler for servicing SMCs.
  ******************************************************************************/
@@ -450,6 +618,12 @@ u_register_t psci_smc_handler(uint32_t smc_fid,
 			ret = (u_register_t)psci_features(r1);
 			break;
 
+#if PSCI_OS_INIT_MODE
+		case PSCI_SET_SUSPEND_MODE:
+			ret = (u_register_t)psci_set_suspend_mode(r1);
+			break;
+#endif
+
 #if ENABLE_PSCI_STAT
 		case PSCI_STAT_RESIDENCY_AARCH32:
 			ret = psci_stat_residency(r1, r2);
@@ -540,3 +714,32 @@ u_register_t psci_smc_handler(uint32_t smc_fid,
 
 	return ret;
 }
+
+/*******************************************************************************
+ * PSCI CPU_SUSPEND SMC handler. It does the same checks and argument
+ * conversion as psci_smc_handler() for this call, without decoding the
+ * function ID. This allows the caller to dispatch this frequent call directly.
+ ******************************************************************************/
+u_register_t psci_cpu_suspend_smc_handler(uint32_t smc_fid,
+					  u_register_t x1,
+					  u_register_t x2,
+					  u_register_t x3,
+					  u_register_t flags)
+{
+	assert((smc_fid == PSCI_CPU_SUSPEND_AARCH32) ||
+	       (smc_fid == PSCI_CPU_SUSPEND_AARCH64));
+
+	if (is_caller_secure(flags))
+		return (u_register_t)SMC_UNK;
+
+	if ((psci_caps & define_psci_cap(smc_fid)) == 0U)
+		return (u_register_t)SMC_UNK;
+
+	if (smc_fid == PSCI_CPU_SUSPEND_AARCH32) {
+		return (u_register_t)psci_cpu_suspend((uint32_t)x1,
+						      (uint32_t)x2,
+						      (uint32_t)x3);
+	}
+
+	return (u_register_t)psci_cpu_suspend((unsigned int)x1, x2, x3);
+}
@@ -45,6 +45,7 @@ int psci_do_cpu_off(unsigned int end_pwrlvl)
 	int rc = PSCI_E_SUCCESS;
 	int idx = (int) plat_my_core_pos();
 	psci_power_state_t state_info;
+	unsigned int locked_lvl = psci_first_locked_lvl(end_pwrlvl);
 
 	/*
 	 * This function must only be called on platforms where the
@@ -60,7 +61,7 @@ int psci_do_cpu_off(unsigned int end_pwrlvl)
 	 * level so that by the time all locks are taken, the system topology
 	 * is snapshot and state management can be done safely.
 	 */
-	psci_acquire_pwr_domain_locks(end_pwrlvl, idx);
+	psci_acquire_pwr_domain_locks(locked_lvl, idx);
 
 	/*
 	 * Call the cpu off handler registered by the Secure Payload Dispatcher
@@ -78,7 +79,8 @@ int psci_do_cpu_off(unsigned int end_pwrlvl)
 	 * it returns the negotiated state info for each power level upto
 	 * the end level specified.
 	 */
-	psci_do_state_coordination(end_pwrlvl, &state_info);
+	locked_lvl = psci_do_state_coordination(end_pwrlvl, locked_lvl,
+						&state_info);
 
 #if ENABLE_PSCI_STAT
 	/* Update the last cpu for each level till end_pwrlvl */
@@ -122,7 +124,7 @@ exit:
 	 * Release the locks corresponding to each power level in the
 	 * reverse order to which they were acquired.
 	 */
-	psci_release_pwr_domain_locks(end_pwrlvl, idx);
+	psci_release_pwr_domain_locks(locked_lvl, idx);
 
 	/*
 	 * Check if all actions needed to safely power down this cpu have
@@ -237,6 +237,21 @@ static inline void psci_lock_release(non_cpu_pd_node_t *non_cpu_pd_node)
 
 #endif /* HW_ASSISTED_COHERENCY */
 
+/*
+ * Highest power level whose lock must be taken before coordinating the power
+ * down of the levels up to 'end_pwrlvl'. With PSCI_HIERARCHICAL_LOCKS, only
+ * the lock of the first level is taken up front, see
+ * psci_do_state_coordination().
+ */
+static inline unsigned int psci_first_locked_lvl(unsigned int end_pwrlvl)
+{
+#if PSCI_HIERARCHICAL_LOCKS
+	if (end_pwrlvl > (PSCI_CPU_PWR_LVL + 1U))
+		return PSCI_CPU_PWR_LVL + 1U;
+#endif
+	return end_pwrlvl;
+}
+
 static inline void psci_lock_init(non_cpu_pd_node_t *non_cpu_pd_node,
 				  unsigned char idx)
 {
@@ -250,6 +265,9 @@ extern const plat_psci_ops_t *psci_plat_pm_ops;
 extern non_cpu_pd_node_t psci_non_cpu_pd_nodes[PSCI_NUM_NON_CPU_PWR_DOMAINS];
 extern cpu_pd_node_t psci_cpu_pd_nodes[PLATFORM_CORE_COUNT];
 extern unsigned int psci_caps;
+#if PSCI_OS_INIT_MODE
+extern suspend_mode_t psci_suspend_mode;
+#endif
 
 /*******************************************************************************
  * SPD's power management hooks registered with PSCI
@@ -272,8 +290,13 @@ int psci_validate_entry_point(entry_point_info_t *ep,
 void psci_get_parent_pwr_domain_nodes(int cpu_idx,
 				      unsigned int end_lvl,
 				      unsigned int *node_index);
-void psci_do_state_coordination(unsigned int end_pwrlvl,
-				psci_power_state_t *state_info);
+unsigned int psci_do_state_coordination(unsigned int end_pwrlvl,
+					unsigned int locked_lvl,
+					psci_power_state_t *state_info);
+#if PSCI_OS_INIT_MODE
+int psci_validate_state_coordination(unsigned int end_pwrlvl,
+				     psci_power_state_t *state_info);
+#endif
 void psci_acquire_pwr_domain_locks(unsigned int end_pwrlvl, int cpu_idx);
 void psci_release_pwr_domain_locks(unsigned int end_pwrlvl, int cpu_idx);
 int psci_validate_suspend_req(const psci_power_state_t *state_info,
@@ -283,6 +306,9 @@ unsigned int psci_find_target_suspend_lvl(const psci_power_state_t *state_info);
 void psci_set_pwr_domains_to_run(unsigned int end_pwrlvl);
 void psci_print_power_domain_map(void);
 unsigned int psci_is_last_on_cpu(void);
+#if PSCI_OS_INIT_MODE
+unsigned int psci_are_all_cpus_on(void);
+#endif
 int psci_spd_migrate_info(u_register_t *mpidr);
 void psci_do_pwrdown_sequence(unsigned int power_level);
 
@@ -303,7 +329,7 @@ void psci_cpu_on_finish(int cpu_idx, const psci_power_state_t *state_info);
 int psci_do_cpu_off(unsigned int end_pwrlvl);
 
 /* Private exported functions from psci_suspend.c */
-void psci_cpu_suspend_start(const entry_point_info_t *ep,
+int psci_cpu_suspend_start(const entry_point_info_t *ep,
 			unsigned int end_pwrlvl,
 			psci_power_state_t *state_info,
 			unsigned int is_power_down_state);
@@ -328,6 +354,9 @@ u_register_t psci_stat_residency(u_register_t target_cpu,
 			unsigned int power_state);
 u_register_t psci_stat_count(u_register_t target_cpu,
 			unsigned int power_state);
+#if PSCI_STAT_SHM
+void psci_stat_shm_init(void);
+#endif
 
 /* Private exported functions from psci_mem_protect.c */
 u_register_t psci_mem_protect(unsigned int enable);
@@ -4,11 +4,17 @@
  * SPDX-License-Identifier: BSD-3-Clause
  */
 
+#define LOG_CATEGORY	LOG_CAT_PSCI
+
 #include <assert.h>
+#include <stdbool.h>
+#include <stddef.h>
 
 #include <platform_def.h>
 
+#include <arch_helpers.h>
 #include <common/debug.h>
+#include <lib/utils.h>
 #include <plat/common/platform.h>
 
 #include "psci_private.h"
@@ -39,6 +45,128 @@ static psci_stat_t psci_cpu_stat[PLATFORM_CORE_COUNT]
 static psci_stat_t psci_non_cpu_stat[PSCI_NUM_NON_CPU_PWR_DOMAINS]
 				[PLAT_MAX_PWR_LVL_STATES];
 
+#if PSCI_STAT_SHM
+#if !(defined(PLAT_PSCI_STAT_SHM_BASE) && defined(PLAT_PSCI_STAT_SHM_SIZE))
+#error "PSCI_STAT_SHM requires PLAT_PSCI_STAT_SHM_BASE and _SIZE"
+#endif
+
+/*
+ * With PSCI_STAT_SHM, the PSCI STAT values are also published in a page of
+ * non-secure memory, so that the normal world can read all of them without
+ * SMCs. The page is only written by this file, the values above remain the
+ * ones returned by the PSCI STAT SMCs.
+ *
+ * Each entry holds the values of a power domain, in the order of the
+ * `psci_stat_t` arrays above, and is only updated by one CPU at a time: a CPU
+ * updates its own entry, and the entry of a non CPU power domain is updated
+ * with the lock of the power domain held. The sequence number of an entry is
+ * odd while it is updated. Readers retry if it is odd or changed while they
+ * read the values. The sequence numbers are kept in secure memory and only
+ * stored to the page, which is never read back.
+ */
+#define PSCI_STAT_SHM_VERSION	U(1)
+
+typedef struct psci_stat_shm_value {
+	uint64_t residency;
+	uint64_t count;
+} psci_stat_shm_value_t;
+
+typedef struct psci_stat_shm_entry {
+	uint32_t seq;
+	uint32_t reserved;
+	psci_stat_shm_value_t stat[PLAT_MAX_PWR_LVL_STATES];
+} __aligned(CACHE_WRITEBACK_GRANULE) psci_stat_shm_entry_t;
+
+typedef struct psci_stat_shm {
+	uint32_t version;
+	uint32_t entry_size;
+	uint32_t states_count;
+	uint32_t cpu_count;
+	uint32_t non_cpu_count;
+	uint32_t cpu_offset;
+	uint32_t non_cpu_offset;
+	psci_stat_shm_entry_t cpu[PLATFORM_CORE_COUNT];
+	psci_stat_shm_entry_t non_cpu[PSCI_NUM_NON_CPU_PWR_DOMAINS];
+} psci_stat_shm_t;
+
+CASSERT(sizeof(psci_stat_shm_t) <= PLAT_PSCI_STAT_SHM_SIZE,
+	assert_psci_stat_shm_size);
+CASSERT((PLAT_PSCI_STAT_SHM_BASE % CACHE_WRITEBACK_GRANULE) == 0U,
+	assert_psci_stat_shm_base_align);
+
+#define psci_stat_shm	((volatile psci_stat_shm_t *)PLAT_PSCI_STAT_SHM_BASE)
+
+static uint32_t psci_stat_shm_cpu_seq[PLATFORM_CORE_COUNT];
+static uint32_t psci_stat_shm_non_cpu_seq[PSCI_NUM_NON_CPU_PWR_DOMAINS];
+
+/* Initialize the header of the page and clear the PSCI STAT values */
+void __init psci_stat_shm_init(void)
+{
+	zeromem((void *)PLAT_PSCI_STAT_SHM_BASE, sizeof(psci_stat_shm_t));
+
+	psci_stat_shm->entry_size = sizeof(psci_stat_shm_entry_t);
+	psci_stat_shm->states_count = PLAT_MAX_PWR_LVL_STATES;
+	psci_stat_shm->cpu_count = PLATFORM_CORE_COUNT;
+	psci_stat_shm->non_cpu_count = PSCI_NUM_NON_CPU_PWR_DOMAINS;
+	psci_stat_shm->cpu_offset = offsetof(psci_stat_shm_t, cpu);
+	psci_stat_shm->non_cpu_offset = offsetof(psci_stat_shm_t, non_cpu);
+
+	/* The version tells readers that the header is valid */
+	dmbst();
+	psci_stat_shm->version = PSCI_STAT_SHM_VERSION;
+}
+
+/*
+ * Publish the PSCI STAT value at 'stat_idx' of an entry of the page, whose
+ * sequence number is at 'seq'.
+ */
+static void psci_stat_shm_update(volatile psci_stat_shm_entry_t *entry,
+				 uint32_t *seq, int stat_idx,
+				 const psci_stat_t *psci_stat)
+{
+	(*seq)++;
+	entry->seq = *seq;
+	dmbst();
+	entry->stat[stat_idx].residency = psci_stat->residency;
+	entry->stat[stat_idx].count = psci_stat->count;
+	dmbst();
+	(*seq)++;
+	entry->seq = *seq;
+}
+#endif
+
+/*
+ * Following is used to keep track of the local states entered by the power
+ * domains of each cpu during its last power down, and of the residency of the
+ * cpu in its local state, for psci_stat_last_idle().
+ *
+ * When a cpu powers down, it also records the number of low power state
+ * entries of each non cpu power domain above it. When it wakes up, a change
+ * in that number tells it that the power domain entered a low power state in
+ * the meantime, even if another cpu of the power domain woke up first and set
+ * it back to RUN.
+ */
+typedef struct psci_last_idle {
+	u_register_t residency;
+	plat_local_state_t pwr_domain_state[PLAT_MAX_PWR_LVL + 1U];
+	unsigned int pd_idle_count[PLAT_MAX_PWR_LVL];
+	bool pd_idle_valid;
+} psci_last_idle_t;
+
+static psci_last_idle_t psci_last_idle[PLATFORM_CORE_COUNT];
+
+/*
+ * Number of low power state entries of each non cpu power domain, and last
+ * local state entered. They are updated by the last cpu to power down in the
+ * power domain, with the lock of the power domain held.
+ */
+typedef struct psci_pd_idle {
+	unsigned int count;
+	plat_local_state_t state;
+} psci_pd_idle_t;
+
+static psci_pd_idle_t psci_pd_idle[PSCI_NUM_NON_CPU_PWR_DOMAINS];
+
 /*
  * This functions returns the index into the `psci_stat_t` array given the
  * local power state and power domain level. If the platform implements the
@@ -82,6 +210,15 @@ void psci_stats_update_pwr_down(unsigned int end_pwrlvl,
 	assert(end_pwrlvl <= PLAT_MAX_PWR_LVL);
 	assert(state_info != NULL);
 
+	/* Record the low power state entries of the power domains so far */
+	parent_idx = psci_cpu_pd_nodes[cpu_idx].parent_node;
+	for (lvl = PSCI_CPU_PWR_LVL + 1U; lvl <= end_pwrlvl; lvl++) {
+		psci_last_idle[cpu_idx].pd_idle_count[lvl - 1U] =
+			psci_pd_idle[parent_idx].count;
+		parent_idx = psci_non_cpu_pd_nodes[parent_idx].parent_node;
+	}
+	psci_last_idle[cpu_idx].pd_idle_valid = true;
+
 	parent_idx = psci_cpu_pd_nodes[cpu_idx].parent_node;
 
 	for (lvl = PSCI_CPU_PWR_LVL + 1U; lvl <= end_pwrlvl; lvl++) {
@@ -96,6 +233,10 @@ void psci_stats_update_pwr_down(unsigned int end_pwrlvl,
 		 */
 		last_cpu_in_non_cpu_pd[parent_idx] = cpu_idx;
 
+		psci_pd_idle[parent_idx].count++;
+		psci_pd_idle[parent_idx].state =
+			state_info->pwr_domain_state[lvl];
+
 		parent_idx = psci_non_cpu_pd_nodes[parent_idx].parent_node;
 	}
 
@@ -114,6 +255,8 @@ void psci_stats_update_pwr_up(unsigned int end_pwrlvl,
 	int stat_idx;
 	plat_local_state_t local_state;
 	u_register_t residency;
+	psci_last_idle_t *last_idle;
+	const psci_pd_idle_t *pd_idle;
 
 	assert(end_pwrlvl <= PLAT_MAX_PWR_LVL);
 	assert(state_info != NULL);
@@ -129,6 +272,38 @@ void psci_stats_update_pwr_up(unsigned int end_pwrlvl,
 	/* Update CPU stats. */
 	psci_cpu_stat[cpu_idx][stat_idx].residency += residency;
 	psci_cpu_stat[cpu_idx][stat_idx].count++;
+#if PSCI_STAT_SHM
+	psci_stat_shm_update(&psci_stat_shm->cpu[cpu_idx],
+			     &psci_stat_shm_cpu_seq[cpu_idx], stat_idx,
+			     &psci_cpu_stat[cpu_idx][stat_idx]);
+#endif
+
+	/*
+	 * Record the states entered by each power level for this CPU. The
+	 * power domains above it are only RUN in 'state_info' if another CPU
+	 * woke them up first, so compare their number of low power state
+	 * entries with the one at the power down of this CPU instead.
+	 */
+	last_idle = &psci_last_idle[cpu_idx];
+	if (last_idle->pd_idle_valid) {
+		last_idle->residency = residency;
+		last_idle->pwr_domain_state[PSCI_CPU_PWR_LVL] = local_state;
+
+		parent_idx = psci_cpu_pd_nodes[cpu_idx].parent_node;
+		for (lvl = PSCI_CPU_PWR_LVL + 1U; lvl <= PLAT_MAX_PWR_LVL;
+		     lvl++) {
+			pd_idle = &psci_pd_idle[parent_idx];
+			if ((lvl <= end_pwrlvl) && (pd_idle->count !=
+					last_idle->pd_idle_count[lvl - 1U]))
+				last_idle->pwr_domain_state[lvl] =
+					pd_idle->state;
+			else
+				last_idle->pwr_domain_state[lvl] =
+					PSCI_LOCAL_STATE_RUN;
+			parent_idx =
+				psci_non_cpu_pd_nodes[parent_idx].parent_node;
+		}
+	}
 
 	/*
 	 * Check what power domains above CPU were off
@@ -161,6 +336,12 @@ void psci_stats_update_pwr_up(unsigned int end_pwrlvl,
 		/* Update non cpu stats */
 		psci_non_cpu_stat[parent_idx][stat_idx].residency += residency;
 		psci_non_cpu_stat[parent_idx][stat_idx].count++;
+#if PSCI_STAT_SHM
+		psci_stat_shm_update(&psci_stat_shm->non_cpu[parent_idx],
+				     &psci_stat_shm_non_cpu_seq[parent_idx],
+				     stat_idx,
+				     &psci_non_cpu_stat[parent_idx][stat_idx]);
+#endif
 
 		parent_idx = psci_non_cpu_pd_nodes[parent_idx].parent_node;
 	}
@@ -248,3 +429,30 @@ u_register_t psci_stat_count(u_register_t target_cpu,
 	else
 		return 0;
 }
+
+/*******************************************************************************
+ * This function returns the local states entered by the power domains of the
+ * calling cpu during its last power down, as coordinated by PSCI, and the
+ * residency of the cpu in its local state. The state of level N is in bits
+ * [8N+7:8N] of 'states'. A power domain above the cpu reports the last state
+ * it entered while the cpu was powered down, whichever cpu of the power domain
+ * woke up first. A power domain that stayed in the RUN state, e.g. because
+ * the coordination demoted the requested state, reports RUN.
+ ******************************************************************************/
+int psci_stat_last_idle(u_register_t *states, u_register_t *residency)
+{
+	unsigned int lvl;
+	const psci_last_idle_t *last_idle =
+		&psci_last_idle[plat_my_core_pos()];
+
+	assert((states != NULL) && (residency != NULL));
+
+	*states = 0U;
+	for (lvl = PSCI_CPU_PWR_LVL; lvl <= PLAT_MAX_PWR_LVL; lvl++) {
+		*states |= (u_register_t)last_idle->pwr_domain_state[lvl] <<
+			(lvl * 8U);
+	}
+	*residency = last_idle->residency;
+
+	return PSCI_E_SUCCESS;
+}
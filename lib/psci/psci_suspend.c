@@ -148,14 +148,26 @@ static void psci_suspend_to_pwrdown_start(unsigned int end_pwrlvl,
  * All the required parameter checks are performed at the beginning and after
  * the state transition has been done, no further error is expected and it is
  * not possible to undo any of the actions taken beyond that point.
+ *
+ * The function returns PSCI_E_SUCCESS when it returns after a wakeup or when
+ * the suspend is abandoned, or the error code of the request validation in
+ * OS-initiated mode.
  ******************************************************************************/
-void psci_cpu_suspend_start(const entry_point_info_t *ep,
-			    unsigned int end_pwrlvl,
-			    psci_power_state_t *state_info,
-			    unsigned int is_power_down_state)
+int psci_cpu_suspend_start(const entry_point_info_t *ep,
+			   unsigned int end_pwrlvl,
+			   psci_power_state_t *state_info,
+			   unsigned int is_power_down_state)
 {
+	int rc = PSCI_E_SUCCESS;
 	int skip_wfi = 0;
 	int idx = (int) plat_my_core_pos();
+	unsigned int locked_lvl = psci_first_locked_lvl(end_pwrlvl);
+
+#if PSCI_OS_INIT_MODE
+	/* The request is validated with all the locks held, see below */
+	if (psci_suspend_mode == OS_INIT)
+		locked_lvl = end_pwrlvl;
+#endif
 
 	/*
 	 * This function must only be called on platforms where the
@@ -169,7 +181,7 @@ void psci_cpu_suspend_start(const entry_point_info_t *ep,
 	 * level so that by the time all locks are taken, the system topology
 	 * is snapshot and state management can be done safely.
 	 */
-	psci_acquire_pwr_domain_locks(end_pwrlvl,
+	psci_acquire_pwr_domain_locks(locked_lvl,
 				      idx);
 
 	/*
@@ -182,12 +194,30 @@ void psci_cpu_suspend_start(const entry_point_info_t *ep,
 		goto exit;
 	}
 
-	/*
-	 * This function is passed the requested state info and
-	 * it returns the negotiated state info for each power level upto
-	 * the end level specified.
-	 */
-	psci_do_state_coordination(end_pwrlvl, state_info);
+#if PSCI_OS_INIT_MODE
+	if (psci_suspend_mode == OS_INIT) {
+		/*
+		 * In OS-initiated mode, the requested state info is the one
+		 * to enter for each power level upto the end level specified,
+		 * provided that it is consistent with the state of the other
+		 * CPUs.
+		 */
+		rc = psci_validate_state_coordination(end_pwrlvl, state_info);
+		if (rc != PSCI_E_SUCCESS) {
+			skip_wfi = 1;
+			goto exit;
+		}
+	} else
+#endif
+	{
+		/*
+		 * This function is passed the requested state info and
+		 * it returns the negotiated state info for each power level
+		 * upto the end level specified.
+		 */
+		locked_lvl = psci_do_state_coordination(end_pwrlvl, locked_lvl,
+							state_info);
+	}
 
 #if ENABLE_PSCI_STAT
 	/* Update the last cpu for each level till end_pwrlvl */
@@ -214,10 +244,10 @@ exit:
 	 * Release the locks corresponding to each power level in the
 	 * reverse order to which they were acquired.
 	 */
-	psci_release_pwr_domain_locks(end_pwrlvl,
+	psci_release_pwr_domain_locks(locked_lvl,
 				  idx);
 	if (skip_wfi == 1)
-		return;
+		return rc;
 
 	if (is_power_down_state != 0U) {
 #if ENABLE_RUNTIME_INSTRUMENTATION
@@ -264,6 +294,8 @@ exit:
 	 * context retaining suspend finisher.
 	 */
 	psci_suspend_to_standby_finisher(idx, end_pwrlvl);
+
+	return rc;
 }
 
 /*******************************************************************************
@@ -7,6 +7,8 @@
  * SPDX-License-Identifier: BSD-3-Clause
  */
 
+#define LOG_CATEGORY	LOG_CAT_XLAT
+
 #include <assert.h>
 #include <stdio.h>
 #include <string.h>
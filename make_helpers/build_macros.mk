@@ -391,6 +391,10 @@ define MAKE_BL
         $(eval BIN        := $(call IMG_BIN,$(1)))
         $(eval BL_LINKERFILE := $(BL$(call uppercase,$(1))_LINKERFILE))
         $(eval BL_LIBS    := $(BL$(call uppercase,$(1))_LIBS))
+        $(eval SYMTAB     := $(BUILD_DIR)/backtrace_symtab)
+        $(eval SYMTAB_OBJ := $(if $(filter 1,$(ENABLE_BACKTRACE_SYMBOLS)),$(SYMTAB).o))
+        $(eval PUBSUB     := $(BUILD_DIR)/pubsub_calls)
+        $(eval PUBSUB_OBJ := $(if $(filter 1,$(PUBSUB_DIRECT_CALLS)),$(PUBSUB).o))
         # We use sort only to get a list of unique object directory names.
         # ordering is not relevant but sort removes duplicates.
         $(eval TEMP_OBJ_DIRS := $(sort $(dir ${OBJS} ${LINKERFILE})))
@@ -417,7 +421,13 @@ ifeq ($(USE_ROMLIB),1)
 $(ELF): romlib.bin
 endif
 
-$(ELF): $(OBJS) $(LINKERFILE) | bl$(1)_dirs libraries $(BL_LIBS)
+# With ENABLE_BACKTRACE_SYMBOLS, the image is first linked with an empty symbol
+# table to find the addresses of the functions. The table is placed after the
+# code, so linking it in doesn't move them, which is checked after the final
+# link.
+# With PUBSUB_DIRECT_CALLS, the publish functions of the events are generated
+# from the symbols of the objects before linking them.
+$(ELF): $(OBJS) $(LINKERFILE) $(if $(SYMTAB_OBJ),$(BACKTRACE_SYMTAB_GEN)) $(if $(PUBSUB_OBJ),$(PUBSUB_CALLS_GEN)) | bl$(1)_dirs libraries $(BL_LIBS)
 	$$(ECHO) "  LD      $$@"
 ifdef MAKE_BUILD_STRINGS
 	$(call MAKE_BUILD_STRINGS, $(BUILD_DIR)/build_message.o)
@@ -434,9 +444,34 @@ ifneq ($(findstring armlink,$(notdir $(LD))),)
 		$(LDPATHS) $(LIBWRAPPER) $(LDLIBS) $(BL_LIBS) \
 		$(BUILD_DIR)/build_message.o $(OBJS)
 else
+ifeq ($(PUBSUB_DIRECT_CALLS),1)
+	$$(Q)$$(NM) -p $(OBJS) | $$(PUBSUB_CALLS_GEN) -o $(PUBSUB).c
+	$$(Q)$$(CC) $$(TF_CFLAGS) $$(CFLAGS) -c $(PUBSUB).c -o $(PUBSUB_OBJ)
+endif
+ifeq ($(ENABLE_BACKTRACE_SYMBOLS),1)
+	$$(Q)$$(BACKTRACE_SYMTAB_GEN) -o $(SYMTAB).S < /dev/null
+	$$(Q)$$(AS) $$(ASFLAGS) -c $(SYMTAB).S -o $(SYMTAB_OBJ)
+	$$(Q)$$(LD) -o $$@ $$(TF_LDFLAGS) $$(LDFLAGS) -Map=$(MAPFILE) \
+		--script $(LINKERFILE) $(BUILD_DIR)/build_message.o \
+		$(OBJS) $(LDPATHS) $(LIBWRAPPER) $(LDLIBS) $(BL_LIBS) \
+		$(PUBSUB_OBJ) $(SYMTAB_OBJ)
+	$$(Q)$$(NM) -S $$@ | $$(BACKTRACE_SYMTAB_GEN) -o $(SYMTAB).S
+	$$(Q)$$(AS) $$(ASFLAGS) -c $(SYMTAB).S -o $(SYMTAB_OBJ)
+endif
 	$$(Q)$$(LD) -o $$@ $$(TF_LDFLAGS) $$(LDFLAGS) -Map=$(MAPFILE) \
 		--script $(LINKERFILE) $(BUILD_DIR)/build_message.o \
-		$(OBJS) $(LDPATHS) $(LIBWRAPPER) $(LDLIBS) $(BL_LIBS)
+		$(OBJS) $(LDPATHS) $(LIBWRAPPER) $(LDLIBS) $(BL_LIBS) \
+		$(PUBSUB_OBJ) $(SYMTAB_OBJ)
+ifeq ($(ENABLE_BACKTRACE_SYMBOLS),1)
+	$$(Q)$$(NM) -S $$@ | $$(BACKTRACE_SYMTAB_GEN) -o $(SYMTAB).check.S
+	$$(Q)cmp -s $(SYMTAB).S $(SYMTAB).check.S || \
+		(echo "Error: functions moved when linking the symbol table"; \
+		 rm -f $$@; exit 1)
+endif
+endif
+ifeq ($(SMC_FID_DISPATCH),1)
+	$$(Q)$$(SMC_FIDS_CHECK) $$(NM) $$(OD) $(if $(filter aarch64,$(ARCH)),16,12) \
+		$$@ || (rm -f $$@; exit 1)
 endif
 ifeq ($(DISABLE_BIN_GENERATION),1)
 	@${ECHO_BLANK_LINE}
@@ -44,6 +44,9 @@ COREBOOT			:= 0
 # For Chain of Trust
 CREATE_KEYS			:= 1
 
+# Save the CPU state to a per-CPU memory record when BL31 crashes
+CRASH_DUMP			:= 0
+
 # Build flag to include AArch32 registers in cpu context save and restore during
 # world switch. This flag must be set to 0 for AArch64-only platforms.
 CTX_INCLUDE_AARCH32_REGS	:= 1
@@ -51,6 +54,12 @@ CTX_INCLUDE_AARCH32_REGS	:= 1
 # Include FP registers in cpu context
 CTX_INCLUDE_FPREGS		:= 0
 
+# Only switch the FP registers between the two worlds when they are used
+CTX_LAZY_FPREGS			:= 0
+
+# Skip the EL1 system register copies that would not change their values
+CTX_WORLD_AFFINITY		:= 0
+
 # Include pointer authentication (ARMv8.3-PAuth) registers in cpu context. This
 # must be set to 1 if the platform wants to use this feature in the Secure
 # world. It is not needed to use it in the Non-secure world.
@@ -69,6 +78,9 @@ DISABLE_BIN_GENERATION		:= 0
 # development platforms.
 DYN_DISABLE_AUTH		:= 0
 
+# Flag to embed a symbol table in the images to symbolise backtraces
+ENABLE_BACKTRACE_SYMBOLS	:= 0
+
 # Build option to enable MPAM for lower ELs
 ENABLE_MPAM_FOR_LOWER_ELS	:= 0
 
@@ -84,6 +96,9 @@ ENABLE_PSCI_STAT		:= 0
 # Flag to enable runtime instrumentation using PMF
 ENABLE_RUNTIME_INSTRUMENTATION	:= 0
 
+# Flag to enable per-function-ID SMC latency statistics using PMF
+ENABLE_SMC_LATENCY_STAT		:= 0
+
 # Flag to enable stack corruption protection
 ENABLE_STACK_PROTECTOR		:= 0
 
@@ -143,9 +158,33 @@ PL011_GENERIC_UART		:= 0
 # The platform Makefile is free to override this value.
 PROGRAMMABLE_RESET_ADDRESS	:= 0
 
+# Skip the validation of CPU_SUSPEND requests for a CPU standby state validated
+# earlier by the same CPU
+PSCI_CPU_STANDBY_CACHE		:= 0
+
 # Flag used to choose the power state format: Extended State-ID or Original
 PSCI_EXTENDED_STATE_ID		:= 0
 
+# Only take the locks of the power domains above the first level when the level
+# below powers down
+PSCI_HIERARCHICAL_LOCKS		:= 0
+
+# Flag to support the OS-initiated mode of CPU_SUSPEND
+PSCI_OS_INIT_MODE		:= 0
+
+# Place the power states requested by each CPU in a cache line of their own
+PSCI_PADDED_REQ_STATES		:= 0
+
+# Count the CPUs requesting each local power state in each power domain, to
+# coordinate the power down without reading the state requested by every CPU
+PSCI_REQ_STATE_COUNTERS		:= 0
+
+# Flag to also publish the PSCI STAT values in a page of non-secure memory
+PSCI_STAT_SHM			:= 0
+
+# Flag to call the pubsub event handlers directly instead of through pointers
+PUBSUB_DIRECT_CALLS		:= 0
+
 # Enable RAS support
 RAS_EXTENSION			:= 0
 
@@ -158,6 +197,14 @@ SAVE_KEYS			:= 0
 # Software Delegated Exception support
 SDEI_SUPPORT            	:= 0
 
+# Dispatch the SMC function IDs registered with DECLARE_RT_SVC_FID() straight
+# to their handler
+SMC_FID_DISPATCH		:= 0
+
+# Pass the SMCCC v1.2 argument and result registers x0-x17 between worlds in
+# the OP-TEE dispatcher and in SPCI
+SMCCC_EXT_REGS			:= 0
+
 # Whether code and read-only data should be put on separate memory pages. The
 # platform Makefile is free to override this value.
 SEPARATE_CODE_AND_RODATA	:= 0
@@ -179,12 +226,19 @@ SPM_MM				:= 1
 # image. This is meant to help debugging the post-BL2 phase.
 SPIN_ON_BL1_EXIT		:= 0
 
+# Flag to enable the batched query call of the Standard Service
+STD_SVC_BATCH			:= 0
+
 # Flags to build TF with Trusted Boot support
 TRUSTED_BOARD_BOOT		:= 0
 
 # Build option to choose whether Trusted Firmware uses Coherent memory or not.
 USE_COHERENT_MEM		:= 1
 
+# Build option to replace the Bakery algorithm of the bakery locks by Lamport's
+# fast mutual exclusion algorithm
+USE_FAST_BAKERY_LOCK		:= 0
+
 # Build option to choose whether Trusted Firmware uses library at ROM
 USE_ROMLIB			:= 0
 
@@ -130,6 +130,10 @@ const mmap_region_t plat_arm_mmap[] = {
 #endif
 #if ENABLE_SPM && !SPM_MM
 	PLAT_MAP_SP_PACKAGE_MEM_RO,
+#endif
+#if PSCI_STAT_SHM
+	MAP_REGION_FLAT(PLAT_PSCI_STAT_SHM_BASE, PLAT_PSCI_STAT_SHM_SIZE,
+			MT_MEMORY | MT_RW | MT_NS),
 #endif
 	{0}
 };
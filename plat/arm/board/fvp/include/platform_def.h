@@ -55,6 +55,16 @@
  */
 #define PLAT_ARM_NS_IMAGE_BASE		(ARM_DRAM1_BASE + UL(0x8000000))
 
+#if PSCI_STAT_SHM
+/*
+ * Page of non-secure memory in which the PSCI STAT values are published. It is
+ * the last page of the non-secure DRAM1, which the normal world must reserve.
+ */
+#define PLAT_PSCI_STAT_SHM_SIZE		UL(0x1000)	/* 4 KB */
+#define PLAT_PSCI_STAT_SHM_BASE		(ARM_NS_DRAM1_END + 1U -	\
+					 PLAT_PSCI_STAT_SHM_SIZE)
+#endif
+
 /*
  * PLAT_ARM_MMAP_ENTRIES depends on the number of entries in the
  * plat_arm_mmap array defined for each BL stage.
@@ -62,12 +72,12 @@
 #if defined(IMAGE_BL31)
 # if ENABLE_SPM
 #  define PLAT_ARM_MMAP_ENTRIES		9
-#  define MAX_XLAT_TABLES		9
+#  define MAX_XLAT_TABLES		(9 + PSCI_STAT_SHM)
 #  define PLAT_SP_IMAGE_MMAP_REGIONS	30
 #  define PLAT_SP_IMAGE_MAX_XLAT_TABLES	10
 # else
 #  define PLAT_ARM_MMAP_ENTRIES		8
-#  define MAX_XLAT_TABLES		5
+#  define MAX_XLAT_TABLES		(5 + PSCI_STAT_SHM)
 # endif
 #elif defined(IMAGE_BL32)
 # define PLAT_ARM_MMAP_ENTRIES		8
@@ -9,8 +9,10 @@
 #include <common/debug.h>
 #include <common/runtime_svc.h>
 #include <lib/pmf/pmf.h>
+#include <lib/psci/psci.h>
 #include <plat/arm/common/arm_sip_svc.h>
 #include <plat/arm/common/plat_arm.h>
+#include <services/std_svc.h>
 #include <tools_share/uuid.h>
 
 /* ARM SiP Service UUID */
@@ -69,6 +71,37 @@ static uintptr_t arm_sip_handler(unsigned int smc_fid,
 				(uint32_t) x4, handle);
 		}
 
+	case ARM_SIP_SVC_CPU_ON_MANY: {
+		u_register_t on_mask;
+		int rc;
+
+		/* Allow calls from non-secure only */
+		if (!is_caller_non_secure(flags))
+			SMC_RET1(handle, PSCI_E_DENIED);
+
+		rc = psci_cpu_on_many(x1, x2, x3, x4, &on_mask);
+		SMC_RET2(handle, rc, on_mask);
+	}
+
+#if ENABLE_PSCI_STAT
+	case ARM_SIP_SVC_PSCI_LAST_IDLE: {
+		u_register_t states, residency;
+		int rc;
+
+		/* Allow calls from non-secure only */
+		if (!is_caller_non_secure(flags))
+			SMC_RET1(handle, PSCI_E_DENIED);
+
+		rc = psci_stat_last_idle(&states, &residency);
+		SMC_RET3(handle, rc, states, residency);
+	}
+#endif
+
+#if STD_SVC_BATCH
+	case ARM_SIP_SVC_BATCH:
+		return std_svc_batch(x1, x2, handle, flags);
+#endif
+
 	case ARM_SIP_SVC_CALL_COUNT:
 		/* PMF calls */
 		call_count += PMF_NUM_SMC_CALLS;
@@ -76,6 +109,19 @@ static uintptr_t arm_sip_handler(unsigned int smc_fid,
 		/* State switch call */
 		call_count += 1;
 
+		/* CPU_ON many call */
+		call_count += 1;
+
+#if ENABLE_PSCI_STAT
+		/* PSCI last idle state call */
+		call_count += 1;
+#endif
+
+#if STD_SVC_BATCH
+		/* Batched query call */
+		call_count += 1;
+#endif
+
 		SMC_RET1(handle, call_count);
 
 	case ARM_SIP_SVC_UID:
@@ -53,6 +53,7 @@ override LIBC_SRCS :=	$(addprefix lib/libc/,		\
 			memmove.c			\
 			memset.c			\
 			printf.c			\
+			printf_format.c			\
 			putchar.c			\
 			strlen.c			\
 			snprintf.c)
@@ -115,6 +115,12 @@ void rpi3_console_init(void)
 		panic();
 	}
 
+	/*
+	 * The TX FIFO of the mini UART holds 8 characters, but THRE is set as
+	 * soon as one of them is free, so only write one character per poll.
+	 */
+	rpi3_console.tx_fifo_depth = 1U;
+
 	console_set_scope(&rpi3_console.console, console_scope);
 }
 
@@ -121,12 +121,16 @@ static uintptr_t arm_arch_svc_smc_handler(uint32_t smc_fid,
 	}
 }
 
-/* Register Standard Service Calls as runtime service */
-DECLARE_RT_SVC(
+/*
+ * Register Standard Service Calls as runtime service. None of the calls
+ * switches worlds, so the handler is called as a leaf handler.
+ */
+DECLARE_RT_SVC_FLAGS(
 		arm_arch_svc,
 		OEN_ARM_START,
 		OEN_ARM_END,
 		SMC_TYPE_FAST,
+		RT_SVC_FLAG_LEAF,
 		NULL,
 		arm_arch_svc_smc_handler
 );
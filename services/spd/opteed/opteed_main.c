@@ -135,6 +135,11 @@ static int32_t opteed_setup(void)
 				dt_addr,
 				&opteed_sp_context[linear_id]);
 
+	/* An AArch64 OPTEE doesn't use the AArch32 EL1 system registers */
+	if (opteed_rw == OPTEE_AARCH64)
+		cm_set_el1_sysregs_groups(CTX_EL1_GROUPS_ALL &
+					  ~CTX_EL1_GROUP_AARCH32);
+
 	/*
 	 * All OPTEED initialization done. Now register our init function with
 	 * BL31 for deferred invocation
@@ -201,6 +206,9 @@ static uintptr_t opteed_smc_handler(uint32_t smc_fid,
 	uint32_t linear_id = plat_my_core_pos();
 	optee_context_t *optee_ctx = &opteed_sp_context[linear_id];
 	uint64_t rc;
+#if SMCCC_EXT_REGS
+	u_register_t regs[SMCCC_GP_REGS_NUM];
+#endif
 
 	/*
 	 * Determine which security state this SMC originated from
@@ -246,6 +254,14 @@ static uintptr_t opteed_smc_handler(uint32_t smc_fid,
 		cm_el1_sysregs_context_restore(SECURE);
 		cm_set_next_eret_context(SECURE);
 
+#if SMCCC_EXT_REGS
+		/*
+		 * Pass all the SMCCC v1.2 argument registers, including the
+		 * hypervisor client ID in x7.
+		 */
+		smc_copy_gp_regs(&optee_ctx->cpu_ctx, 4U, handle, 4U,
+				 SMCCC_GP_REGS_NUM - 4U);
+#else
 		write_ctx_reg(get_gpregs_ctx(&optee_ctx->cpu_ctx),
 			      CTX_GPREG_X4,
 			      read_ctx_reg(get_gpregs_ctx(handle),
@@ -263,6 +279,7 @@ static uintptr_t opteed_smc_handler(uint32_t smc_fid,
 			      CTX_GPREG_X7,
 			      read_ctx_reg(get_gpregs_ctx(handle),
 					   CTX_GPREG_X7));
+#endif
 
 		SMC_RET4(&optee_ctx->cpu_ctx, smc_fid, x1, x2, x3);
 	}
@@ -356,7 +373,7 @@ static uintptr_t opteed_smc_handler(uint32_t smc_fid,
 	case TEESMC_OPTEED_RETURN_CALL_DONE:
 		/*
 		 * This is the result from the secure client of an
-		 * earlier request. The results are in x0-x3. Copy it
+		 * earlier request. The results are in x1-x4. Copy it
 		 * into the non-secure context, save the secure state
 		 * and return to the non-secure state.
 		 */
@@ -371,7 +388,14 @@ static uintptr_t opteed_smc_handler(uint32_t smc_fid,
 		cm_el1_sysregs_context_restore(NON_SECURE);
 		cm_set_next_eret_context(NON_SECURE);
 
+#if SMCCC_EXT_REGS
+		/* The results are in x1 - x17, x17 of the caller is kept */
+		get_smc_regs_from_ctx(handle, regs);
+		SMC_RET_REGS(ns_cpu_context, &regs[1],
+			     SMCCC_GP_REGS_NUM - 1U);
+#else
 		SMC_RET4(ns_cpu_context, x1, x2, x3, x4);
+#endif
 
 	/*
 	 * OPTEE has finished handling a S-EL1 FIQ interrupt. Execution
@@ -83,6 +83,7 @@ static struct smc_args trusty_context_switch(uint32_t security_state, uint64_t r
 	struct smc_args args, ret_args;
 	struct trusty_cpu_ctx *ctx = get_trusty_ctx();
 	struct trusty_cpu_ctx *ctx_smc;
+	bool switch_fpregs;
 
 	assert(ctx->saved_security_state != security_state);
 
@@ -106,10 +107,14 @@ static struct smc_args trusty_context_switch(uint32_t security_state, uint64_t r
 	 * To avoid the additional overhead in PSCI flow, skip FP context
 	 * saving/restoring in case of CPU suspend and resume, assuming that
 	 * when it's needed the PSCI caller has preserved FP context before
-	 * going here.
+	 * going here. With CTX_LAZY_FPREGS, the FP context is only switched
+	 * when it is used, so it is always switched.
 	 */
-	if (r0 != SMC_FC_CPU_SUSPEND && r0 != SMC_FC_CPU_RESUME)
-		fpregs_context_save(get_fpregs_ctx(cm_get_context(security_state)));
+	switch_fpregs = (CTX_LAZY_FPREGS != 0) ||
+			((r0 != SMC_FC_CPU_SUSPEND) && (r0 != SMC_FC_CPU_RESUME));
+
+	if (switch_fpregs)
+		cm_fpregs_context_save(security_state);
 	cm_el1_sysregs_context_save(security_state);
 
 	ctx->saved_security_state = security_state;
@@ -118,8 +123,8 @@ static struct smc_args trusty_context_switch(uint32_t security_state, uint64_t r
 	assert(ctx->saved_security_state == ((security_state == 0U) ? 1U : 0U));
 
 	cm_el1_sysregs_context_restore(security_state);
-	if (r0 != SMC_FC_CPU_SUSPEND && r0 != SMC_FC_CPU_RESUME)
-		fpregs_context_restore(get_fpregs_ctx(cm_get_context(security_state)));
+	if (switch_fpregs)
+		cm_fpregs_context_restore(security_state);
 
 	cm_set_next_eret_context(security_state);
 
@@ -299,7 +304,7 @@ static int32_t trusty_init(void)
 	ep_info = bl31_plat_get_next_image_ep_info(SECURE);
 	assert(ep_info != NULL);
 
-	fpregs_context_save(get_fpregs_ctx(cm_get_context(NON_SECURE)));
+	cm_fpregs_context_save(NON_SECURE);
 	cm_el1_sysregs_context_save(NON_SECURE);
 
 	cm_set_context(&ctx->cpu_ctx, SECURE);
@@ -316,7 +321,7 @@ static int32_t trusty_init(void)
 	}
 
 	cm_el1_sysregs_context_restore(SECURE);
-	fpregs_context_restore(get_fpregs_ctx(cm_get_context(SECURE)));
+	cm_fpregs_context_restore(SECURE);
 	cm_set_next_eret_context(SECURE);
 
 	ctx->saved_security_state = ~0U; /* initial saved state is invalid */
@@ -325,7 +330,7 @@ static int32_t trusty_init(void)
 	(void)trusty_context_switch_helper(&ctx->saved_sp, &zero_args);
 
 	cm_el1_sysregs_context_restore(NON_SECURE);
-	fpregs_context_restore(get_fpregs_ctx(cm_get_context(NON_SECURE)));
+	cm_fpregs_context_restore(NON_SECURE);
 	cm_set_next_eret_context(NON_SECURE);
 
 	return 1;
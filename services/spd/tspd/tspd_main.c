@@ -219,6 +219,13 @@ static int32_t tspd_setup(void)
 				tsp_ep_info->pc,
 				&tspd_sp_context[linear_id]);
 
+	/*
+	 * The TSP only runs at S-EL1 in AArch64 and doesn't use the EL0
+	 * thread ID registers, so it doesn't use the optional groups of EL1
+	 * system registers.
+	 */
+	cm_set_el1_sysregs_groups(0U);
+
 #if TSP_INIT_ASYNC
 	bl31_set_next_image_type(SECURE);
 #else
@@ -4,6 +4,8 @@
  * SPDX-License-Identifier: BSD-3-Clause
  */
 
+#define LOG_CATEGORY	LOG_CAT_SDEI
+
 #include <arch_helpers.h>
 #include <assert.h>
 #include <stddef.h>
@@ -925,6 +927,28 @@ static uint64_t sdei_features(unsigned int feature)
 	return (uint64_t) SDEI_EINVAL;
 }
 
+/* Handle SDEI_EVENT_COMPLETE and SDEI_EVENT_COMPLETE_AND_RESUME */
+static uint64_t sdei_complete_smc(cpu_context_t *ctx, bool resume, uint64_t x1)
+{
+	int64_t ret;
+
+	SDEI_LOG("> COMPLETE(r:%u sta/ep:%llx):%lx\n",
+			(unsigned int) resume, x1, read_mpidr_el1());
+	ret = sdei_event_complete(resume, x1);
+	SDEI_LOG("< COMPLETE:%llx\n", ret);
+
+	/*
+	 * Set error code only if the call failed. If the call succeeded, we
+	 * discard the dispatched context, and restore the interrupted context
+	 * to a pristine condition, and therefore shouldn't be modified. We
+	 * don't return to the caller in this case anyway.
+	 */
+	if (ret != 0)
+		SMC_RET1(ctx, ret);
+
+	SMC_RET0(ctx);
+}
+
 /* SDEI top level handler for servicing SMCs */
 uint64_t sdei_smc_handler(uint32_t smc_fid,
 			  uint64_t x1,
@@ -988,22 +1012,7 @@ uint64_t sdei_smc_handler(uint32_t smc_fid,
 		/* Fallthrough */
 
 	case SDEI_EVENT_COMPLETE:
-		SDEI_LOG("> COMPLETE(r:%u sta/ep:%llx):%lx\n",
-				(unsigned int) resume, x1, read_mpidr_el1());
-		ret = sdei_event_complete(resume, x1);
-		SDEI_LOG("< COMPLETE:%llx\n", ret);
-
-		/*
-		 * Set error code only if the call failed. If the call
-		 * succeeded, we discard the dispatched context, and restore the
-		 * interrupted context to a pristine condition, and therefore
-		 * shouldn't be modified. We don't return to the caller in this
-		 * case anyway.
-		 */
-		if (ret != 0)
-			SMC_RET1(ctx, ret);
-
-		SMC_RET0(ctx);
+		return sdei_complete_smc(ctx, resume, x1);
 
 	case SDEI_EVENT_STATUS:
 		SDEI_LOG("> STAT(n:%d)\n", ev_num);
@@ -1086,6 +1095,38 @@ uint64_t sdei_smc_handler(uint32_t smc_fid,
 	SMC_RET1(ctx, SMC_UNK);
 }
 
+#if SMC_FID_DISPATCH
+/*
+ * Handler for the SDEI event completion calls, issued at the end of every
+ * dispatched event, called directly from the SMC entry path without going
+ * through the Standard Service and sdei_smc_handler().
+ */
+static uintptr_t sdei_complete_smc_handler(uint32_t smc_fid,
+					   u_register_t x1,
+					   u_register_t x2,
+					   u_register_t x3,
+					   u_register_t x4,
+					   void *cookie,
+					   void *handle,
+					   u_register_t flags)
+{
+	if (get_interrupt_src_ss(flags) != NON_SECURE)
+		SMC_RET1(handle, SMC_UNK);
+
+	/* Verify the caller EL */
+	if (GET_EL(read_spsr_el3()) != sdei_client_el())
+		SMC_RET1(handle, SMC_UNK);
+
+	return sdei_complete_smc(handle,
+			smc_fid == SDEI_EVENT_COMPLETE_AND_RESUME, x1);
+}
+
+DECLARE_RT_SVC_FID(sdei_complete, SDEI_EVENT_COMPLETE,
+		   sdei_complete_smc_handler);
+DECLARE_RT_SVC_FID(sdei_complete_and_resume, SDEI_EVENT_COMPLETE_AND_RESUME,
+		   sdei_complete_smc_handler);
+#endif /* SMC_FID_DISPATCH */
+
 /* Subscribe to PSCI CPU on to initialize per-CPU SDEI configuration */
 SUBSCRIBE_TO_EVENT(psci_cpu_on_finish, sdei_cpu_on_init);
 
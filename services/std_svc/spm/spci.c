@@ -4,6 +4,8 @@
  * SPDX-License-Identifier: BSD-3-Clause
  */
 
+#define LOG_CATEGORY	LOG_CAT_SPM
+
 #include <assert.h>
 #include <errno.h>
 #include <string.h>
@@ -274,7 +276,9 @@ static uint64_t spci_service_request_blocking(void *handle,
 	sp_context_t *sp_ctx;
 	cpu_context_t *cpu_ctx;
 	uint32_t rx0;
+#if !SMCCC_EXT_REGS
 	u_register_t rx1, rx2, rx3;
+#endif
 	uint16_t request_handle, client_id;
 
 	/* Get handle array lock */
@@ -358,9 +362,18 @@ static uint64_t spci_service_request_blocking(void *handle,
 		panic();
 	}
 
+#if SMCCC_EXT_REGS
+	/*
+	 * Return all the response registers of the Secure Partition, x3 -
+	 * x17, in x1 - x15. This must be done before the partition is
+	 * flagged as idle and its context may be reused.
+	 */
+	smc_copy_gp_regs(handle, 1U, cpu_ctx, 3U, SMCCC_GP_REGS_NUM - 3U);
+#else
 	rx1 = read_ctx_reg(get_gpregs_ctx(cpu_ctx), CTX_GPREG_X3);
 	rx2 = read_ctx_reg(get_gpregs_ctx(cpu_ctx), CTX_GPREG_X4);
 	rx3 = read_ctx_reg(get_gpregs_ctx(cpu_ctx), CTX_GPREG_X5);
+#endif
 
 	/* Flag Secure Partition as idle. */
 	assert(sp_ctx->state == SP_STATE_BUSY);
@@ -376,7 +389,11 @@ static uint64_t spci_service_request_blocking(void *handle,
 	cm_el1_sysregs_context_restore(NON_SECURE);
 	cm_set_next_eret_context(NON_SECURE);
 
+#if SMCCC_EXT_REGS
+	SMC_RET1(handle, SPCI_SUCCESS);
+#else
 	SMC_RET4(handle, SPCI_SUCCESS, rx1, rx2, rx3);
+#endif
 }
 
 /*******************************************************************************
@@ -4,6 +4,8 @@
  * SPDX-License-Identifier: BSD-3-Clause
  */
 
+#define LOG_CATEGORY	LOG_CAT_SPM
+
 #include <assert.h>
 #include <errno.h>
 #include <string.h>
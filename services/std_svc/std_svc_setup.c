@@ -7,6 +7,8 @@
 #include <assert.h>
 #include <stdint.h>
 
+#include <platform_def.h>
+
 #include <common/debug.h>
 #include <common/runtime_svc.h>
 #include <lib/el3_runtime/cpu_data.h>
@@ -59,6 +61,84 @@ static int32_t std_svc_setup(void)
 	return ret;
 }
 
+#if STD_SVC_BATCH
+#if !defined(PLAT_STD_SVC_BATCH_BUF_BASE) || !defined(PLAT_STD_SVC_BATCH_BUF_SIZE)
+#error "STD_SVC_BATCH requires the platform to define the batch buffer"
+#endif
+
+/*
+ * Make the calls described by the 'count' records at 'addr' in the platform
+ * batch buffer. Only calls that don't change the state of the system are
+ * permitted, so that the records can be processed in any order and a failure
+ * doesn't have to be unwound.
+ */
+uintptr_t std_svc_batch(u_register_t addr,
+			       u_register_t count,
+			       void *handle,
+			       u_register_t flags)
+{
+	std_svc_batch_rec_t *rec = (std_svc_batch_rec_t *)addr;
+	u_register_t offset;
+	uint32_t fid;
+#if ENABLE_PMF
+	u_register_t mpidr;
+	unsigned long long ts;
+#endif
+
+	if (is_caller_secure(flags))
+		SMC_RET1(handle, SMC_UNK);
+
+	offset = addr - PLAT_STD_SVC_BATCH_BUF_BASE;
+	if ((addr < PLAT_STD_SVC_BATCH_BUF_BASE) ||
+	    (offset > PLAT_STD_SVC_BATCH_BUF_SIZE) ||
+	    ((addr & (sizeof(uint64_t) - 1U)) != 0U) ||
+	    (count > ((PLAT_STD_SVC_BATCH_BUF_SIZE - offset) /
+		      sizeof(std_svc_batch_rec_t))))
+		SMC_RET1(handle, PSCI_E_INVALID_PARAMS);
+
+	for (; count != 0U; count--, rec++) {
+		fid = (uint32_t)rec->fid;
+		rec->ret[1] = 0ULL;
+
+		switch (fid) {
+		case PSCI_VERSION:
+		case PSCI_AFFINITY_INFO_AARCH32:
+		case PSCI_AFFINITY_INFO_AARCH64:
+		case PSCI_FEATURES:
+		case PSCI_NODE_HW_STATE_AARCH32:
+		case PSCI_NODE_HW_STATE_AARCH64:
+		case PSCI_STAT_RESIDENCY_AARCH32:
+		case PSCI_STAT_RESIDENCY_AARCH64:
+		case PSCI_STAT_COUNT_AARCH32:
+		case PSCI_STAT_COUNT_AARCH64:
+			rec->ret[0] = psci_smc_handler(fid, rec->args[0],
+					rec->args[1], rec->args[2], 0U, NULL,
+					handle, flags);
+			break;
+
+#if ENABLE_PMF
+		case PMF_SMC_GET_TIMESTAMP_32:
+		case PMF_SMC_GET_TIMESTAMP_64:
+			mpidr = rec->args[1];
+			if (fid == PMF_SMC_GET_TIMESTAMP_32)
+				mpidr = (uint32_t)mpidr;
+			rec->ret[0] = (uint64_t)(int64_t)pmf_get_timestamp_smc(
+					(unsigned int)rec->args[0], mpidr,
+					(unsigned int)rec->args[2], &ts);
+			rec->ret[1] = ts;
+			break;
+#endif
+
+		default:
+			rec->ret[0] = (uint64_t)(int64_t)SMC_UNK;
+			break;
+		}
+	}
+
+	SMC_RET1(handle, SMC_OK);
+}
+#endif /* STD_SVC_BATCH */
+
 /*
  * Top-level Standard Service SMC handler. This handler will in turn dispatch
  * calls to PSCI SMC handler
@@ -143,6 +223,84 @@ static uintptr_t std_svc_smc_handler(uint32_t smc_fid,
 	}
 }
 
+#if SMC_FID_DISPATCH
+/*
+ * PSCI CPU_SUSPEND handler, called directly from the SMC entry path without
+ * going through std_svc_smc_handler() and psci_smc_handler().
+ */
+static uintptr_t std_svc_psci_cpu_suspend(uint32_t smc_fid,
+			     u_register_t x1,
+			     u_register_t x2,
+			     u_register_t x3,
+			     u_register_t x4,
+			     void *cookie,
+			     void *handle,
+			     u_register_t flags)
+{
+	uint64_t ret;
+
+#if ENABLE_RUNTIME_INSTRUMENTATION
+	PMF_WRITE_TIMESTAMP(rt_instr_svc,
+	    RT_INSTR_ENTER_PSCI,
+	    PMF_CACHE_MAINT,
+	    get_cpu_data(cpu_data_pmf_ts[CPU_DATA_PMF_TS0_IDX]));
+#endif
+
+	ret = psci_cpu_suspend_smc_handler(smc_fid, x1, x2, x3, flags);
+
+#if ENABLE_RUNTIME_INSTRUMENTATION
+	PMF_CAPTURE_TIMESTAMP(rt_instr_svc,
+	    RT_INSTR_EXIT_PSCI,
+	    PMF_NO_CACHE_MAINT);
+#endif
+
+	SMC_RET1(handle, ret);
+}
+
+DECLARE_RT_SVC_FID(psci_cpu_suspend32, PSCI_CPU_SUSPEND_AARCH32,
+		   std_svc_psci_cpu_suspend);
+DECLARE_RT_SVC_FID(psci_cpu_suspend64, PSCI_CPU_SUSPEND_AARCH64,
+		   std_svc_psci_cpu_suspend);
+
+/*
+ * Handler of the PSCI calls that only return information, called directly
+ * from the SMC entry path as a leaf handler.
+ */
+static uintptr_t std_svc_psci_query(uint32_t smc_fid,
+			     u_register_t x1,
+			     u_register_t x2,
+			     u_register_t x3,
+			     u_register_t x4,
+			     void *cookie,
+			     void *handle,
+			     u_register_t flags)
+{
+	uint64_t ret;
+
+#if ENABLE_RUNTIME_INSTRUMENTATION
+	PMF_WRITE_TIMESTAMP(rt_instr_svc,
+	    RT_INSTR_ENTER_PSCI,
+	    PMF_CACHE_MAINT,
+	    get_cpu_data(cpu_data_pmf_ts[CPU_DATA_PMF_TS0_IDX]));
+#endif
+
+	ret = psci_smc_handler(smc_fid, x1, x2, x3, x4, cookie, handle, flags);
+
+#if ENABLE_RUNTIME_INSTRUMENTATION
+	PMF_CAPTURE_TIMESTAMP(rt_instr_svc,
+	    RT_INSTR_EXIT_PSCI,
+	    PMF_NO_CACHE_MAINT);
+#endif
+
+	SMC_RET1(handle, ret);
+}
+
+DECLARE_RT_SVC_FID_FLAGS(psci_version, PSCI_VERSION, RT_SVC_FLAG_LEAF,
+			 std_svc_psci_query);
+DECLARE_RT_SVC_FID_FLAGS(psci_features, PSCI_FEATURES, RT_SVC_FLAG_LEAF,
+			 std_svc_psci_query);
+#endif /* SMC_FID_DISPATCH */
+
 /* Register Standard Service Calls as runtime service */
 DECLARE_RT_SVC(
 		std_svc,